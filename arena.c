@@ -0,0 +1,149 @@
+/*
+ * arena.c: Virtual Machine Placement with OverSubscription Problem - Generation Arena
+ * Date: 17-10-2026
+ *
+ * Allocations are a pointer increment in the arena memory. When a generation needs more
+ * memory than the arena has, the rest is reserved in overflow chunks, and the next reset
+ * grows the arena memory to fit all of it, so the following generations do not overflow
+ * and a reset is only a counter set to zero.
+*/
+
+/* include arena header */
+#include "arena.h"
+
+/* align_size: rounds a size up to the arena alignment
+ * parameter: size in bytes
+ * returns: aligned size in bytes
+*/
+static size_t align_size(size_t size)
+{
+	return (size + ARENA_ALIGNMENT - 1) & ~((size_t) ARENA_ALIGNMENT - 1);
+}
+
+/* aligned_memory: reserves aligned memory, finishing the execution if there is no memory
+ * parameter: size in bytes
+ * returns: pointer to the memory
+*/
+static void *aligned_memory(size_t size)
+{
+	void *memory = NULL;
+
+	if (posix_memalign(&memory, ARENA_ALIGNMENT, size > 0 ? size : ARENA_ALIGNMENT) != 0)
+	{
+		printf ("[ERROR]: Problem with memory space. Function posix_memalign failed!\n");
+		exit (EXIT_FAILURE);
+	}
+	return memory;
+}
+
+/* arena_create: creates an arena
+ * parameter: initial size of the arena memory, in bytes
+ * returns: arena
+*/
+struct arena *arena_create(size_t size)
+{
+	struct arena *arena = (struct arena *) malloc (sizeof (struct arena));
+
+	if (arena == NULL)
+	{
+		printf ("[ERROR]: Problem with memory space. Function malloc returned NULL!\n");
+		exit (EXIT_FAILURE);
+	}
+
+	arena->size = align_size(size);
+	arena->memory = (char *) aligned_memory(arena->size);
+	arena->used = 0;
+	arena->overflow = NULL;
+	arena->overflow_size = 0;
+
+	return arena;
+}
+
+/* arena_alloc: reserves memory from an arena
+ * parameter: arena, or NULL to reserve the memory with malloc (released with free)
+ * parameter: size in bytes
+ * returns: pointer to the memory, aligned to ARENA_ALIGNMENT when it comes from an arena
+*/
+void *arena_alloc(struct arena *arena, size_t size)
+{
+	void *memory;
+	struct arena_chunk *chunk;
+
+	if (arena == NULL)
+	{
+		memory = malloc (size > 0 ? size : 1);
+		if (memory == NULL)
+		{
+			printf ("[ERROR]: Problem with memory space. Function malloc returned NULL!\n");
+			exit (EXIT_FAILURE);
+		}
+		return memory;
+	}
+
+	size = align_size(size);
+
+	if (arena->used + size <= arena->size)
+	{
+		memory = arena->memory + arena->used;
+		arena->used += size;
+		return memory;
+	}
+
+	/* the arena is exhausted: the block goes to an overflow chunk, with the chunk header in the first line */
+	chunk = (struct arena_chunk *) aligned_memory(ARENA_ALIGNMENT + size);
+	chunk->next = arena->overflow;
+	arena->overflow = chunk;
+	arena->overflow_size += size;
+
+	return (char *) chunk + ARENA_ALIGNMENT;
+}
+
+/* arena_reset: releases all the memory reserved from an arena
+ * parameter: arena
+ * returns: nothing, it's void
+*/
+void arena_reset(struct arena *arena)
+{
+	struct arena_chunk *chunk;
+
+	/* the arena was too small: it is grown to the size used since the last reset */
+	if (arena->overflow != NULL)
+	{
+		while (arena->overflow != NULL)
+		{
+			chunk = arena->overflow;
+			arena->overflow = chunk->next;
+			free(chunk);
+		}
+
+		free(arena->memory);
+		arena->size += arena->overflow_size;
+		arena->memory = (char *) aligned_memory(arena->size);
+		arena->overflow_size = 0;
+	}
+
+	arena->used = 0;
+}
+
+/* arena_free: releases an arena and all its memory
+ * parameter: arena
+ * returns: nothing, it's void
+*/
+void arena_free(struct arena *arena)
+{
+	struct arena_chunk *chunk;
+
+	if (arena == NULL)
+		return;
+
+	/* the overflow chunks are freed without growing the arena, like arena_reset does */
+	while (arena->overflow != NULL)
+	{
+		chunk = arena->overflow;
+		arena->overflow = chunk->next;
+		free(chunk);
+	}
+
+	free(arena->memory);
+	free(arena);
+}
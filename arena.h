@@ -0,0 +1,45 @@
+/*
+ * arena.h: Virtual Machine Placement with OverSubscription Problem - Generation Arena Header
+ * Date: 17-10-2026
+ *
+ * An arena hands out memory from one big block and releases all of it at once. The main
+ * loop takes every temporary of a generation (Q, its commitment matrix, its utilization,
+ * objective functions and fronts) from an arena that is reset at the end of the generation.
+*/
+
+#ifndef ARENA_H
+#define ARENA_H
+
+/* include libraries */
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+/* alignment of every block handed out by an arena, one cache line */
+#define ARENA_ALIGNMENT 64
+
+/* block reserved when the arena memory is exhausted, released in the next reset */
+struct arena_chunk
+{
+	struct arena_chunk *next;
+};
+
+/* structure of an arena */
+struct arena
+{
+	/* memory of the arena and bytes in use */
+	char *memory;
+	size_t size;
+	size_t used;
+	/* blocks reserved out of the arena memory since the last reset */
+	struct arena_chunk *overflow;
+	size_t overflow_size;
+};
+
+/* function headers definitions */
+struct arena *arena_create(size_t size);
+void *arena_alloc(struct arena *arena, size_t size);
+void arena_reset(struct arena *arena);
+void arena_free(struct arena *arena);
+
+#endif
@@ -13,27 +13,32 @@
 #include "commitment.h"
 
 /* calculates_commitment: calculates the Commitment Matrix
- * parameter: population matrix
+ * parameter: solver context
+ * parameter: population
  * parameter: number of individuals
  * parameter: number of physical machines
  * parameter: number of virtual machines
  * parameter: virtual machines requirements matrix
+ * parameter: arena to take the matrix from, or NULL to use malloc (the rows are one block, commitment[0])
  * returns: commitment matrix
 */
-float **calculates_commitment(int **population, int number_of_individuals, int h_size, int v_size, int **V, int CRITICAL_SERVICES)
+float **calculates_commitment(struct vmpos_context *context, struct population *population, int number_of_individuals, int h_size, int v_size, int **V, int CRITICAL_SERVICES, struct arena *arena)
 {
 	// iterators 
 	int iterator_individual;
 	int iterator_virtual;
 	int iterator_physical;
+	int *individual;
 
-    //* commitment: initial Commitment Matrix 
-	float **commitment = (float **) malloc (number_of_individuals *sizeof (float *));
+    //* commitment: initial Commitment Matrix, with all the rows in one block
+	float **commitment = (float **) arena_alloc (arena, number_of_individuals *sizeof (float *));
+	float *commitment_data = (float *) arena_alloc (arena, ((size_t) number_of_individuals * h_size + 1) *sizeof (float));
 
  	// iterate on individuals
 	for (iterator_individual=0; iterator_individual < number_of_individuals; iterator_individual++)
 	{
-		commitment[iterator_individual] = (float *) malloc (h_size *sizeof (float));
+		commitment[iterator_individual] = commitment_data + (size_t) iterator_individual * h_size;
+		individual = INDIVIDUAL(population, iterator_individual);
 
 		for (iterator_physical=0; iterator_physical < h_size; iterator_physical++)
 		{
@@ -45,20 +50,20 @@ float **calculates_commitment(int **population, int number_of_individuals, int h
 		for (iterator_virtual = 0; iterator_virtual < v_size; iterator_virtual++)
 		{
 			// VM with no CRITICAL_SERVICES
-			if (V[iterator_virtual][3] != CRITICAL_SERVICES)
+			if (V[3][iterator_virtual] != CRITICAL_SERVICES)
 			{
-				if (population[iterator_individual][iterator_virtual] != 0)
+				if (individual[iterator_virtual] != 0)
 				{
 					// Only change the Commitment Level if the PM was not set with Critical Services
-					if (commitment[iterator_individual][(population[iterator_individual][iterator_virtual])-1] != cl_cs)
-						commitment[iterator_individual][(population[iterator_individual][iterator_virtual])-1] = cl_nc;
+					if (commitment[iterator_individual][(individual[iterator_virtual])-1] != context->cl_cs)
+						commitment[iterator_individual][(individual[iterator_virtual])-1] = context->cl_nc;
 				}
 			}
 			// VM with CRITICAL_SERVICES
 			else
 			{
-				if (population[iterator_individual][iterator_virtual] != 0)
-					commitment[iterator_individual][(population[iterator_individual][iterator_virtual])-1] = cl_cs;
+				if (individual[iterator_virtual] != 0)
+					commitment[iterator_individual][(individual[iterator_virtual])-1] = context->cl_cs;
 			}
 		}
 	}
@@ -67,106 +72,53 @@ float **calculates_commitment(int **population, int number_of_individuals, int h
 }
 
 
-/* update_commitment_line: updates one line of the Commitment Matrix
- * parameter: population matrix
- * parameter: commitment matrix
- * parameter: virtual machines requirements matrix
- * parameter: the individual overloaded
- * parameter: number of physical machines
- * parameter: number of virtual machines
- * returns: nothing, it's void
+/* commitment_level: calculates the Commitment Level of a PM from the VMs it hosts
+ * parameter: solver context
+ * parameter: population, with its evaluation loaded
+ * parameter: individual
+ * parameter: physical machine
+ * returns: cl_cs if the PM hosts any VM with critical services, cl_nc if it only hosts VMs with no critical services, 0.0 if it is empty
 */
-void update_commitment_line (int **population, float **cm, int **V, int individual_overloaded, int h_size, int v_size, int CRITICAL_SERVICES)
+float commitment_level(struct vmpos_context *context, struct population *population, int individual, int physical)
 {
-	int iterator_virtual;
-	int iterator_physical;
-	
-	for (iterator_physical=0; iterator_physical < h_size; iterator_physical++)
-	{
-		//* Commitment Level of PMs initialized to 0 
-		cm[individual_overloaded][iterator_physical] = 0.0;
-	}
-	
-	for (iterator_virtual = 0; iterator_virtual < v_size; iterator_virtual++)
-	{
-		// VM with no CRITICAL_SERVICES
-		if (V[iterator_virtual][3] != CRITICAL_SERVICES)
-		{
-			if (population[individual_overloaded][iterator_virtual] != 0)
-			{
-				// Only change the Commitment Level if the PM was not set with Critical Services
-				if (cm[individual_overloaded][(population[individual_overloaded][iterator_virtual])-1] != cl_cs)
-					cm[individual_overloaded][(population[individual_overloaded][iterator_virtual])-1] = cl_nc;
-			}
-		}
-		// VM with CRITICAL_SERVICES
-		else
-		{
-			if (population[individual_overloaded][iterator_virtual] != 0) // Vai ser gerado valor diferente de zero. Pensar se vai ser em todas as situações
-				cm[individual_overloaded][(population[individual_overloaded][iterator_virtual])-1] = cl_cs;
-		}
-	}
+	struct physical_evaluation *evaluation = PHYSICAL_EVALUATION(population, individual, physical);
+
+	PROFILE_COUNT(PROFILE_COMMITMENT_UPDATES);
+
+	if (evaluation->critical_vms > 0)
+		return context->cl_cs;
+	if (evaluation->no_critical_vms > 0)
+		return context->cl_nc;
+	return 0.0;
 }
 
 
 /* calculates_commitment_line: verify if one VM can migrate to a PM
- * parameter: one individual
- * parameter: the VM to be updated
- * parameter: the PM to be updated
+ * parameter: solver context
+ * parameter: population, with its evaluation loaded
  * parameter: commitment matrix
- * parameter: PM that will receive the VM
- * parameter: number of physical machines
- * parameter: number of virtual machines
  * parameter: virtual machines requirements matrix
+ * parameter: individual
+ * parameter: the VM to be updated
+ * parameter: PM that will receive the VM (position in the individual, from 1)
  * returns: 1 if can migrate the VM or 0 if can't
 */
-int calculates_commitment_line(int *actual_population_line, int vm_to_update, int h_to_update, float **actual_cm, int individual_adjustment, int h_size, int v_size, int **V, int CRITICAL_SERVICES)
+int calculates_commitment_line(struct vmpos_context *context, struct population *population, float **cm, int **V, int individual, int vm_to_update, int h_to_update, int CRITICAL_SERVICES)
 {
-	int iterator_virtual;
-	int iterator_physical;
-
-	int *population_line_after = (int *) malloc (v_size *sizeof (int));
-	float *cm_line_after = (float *) malloc (h_size *sizeof (float));
-
-
-	//* Commitment Level of PMs initialized to 0 
-	for (iterator_physical=0; iterator_physical < h_size; iterator_physical++)
-		cm_line_after[iterator_physical] = 0.0;
-	
-	for (iterator_virtual = 0; iterator_virtual < v_size; iterator_virtual++)
-	{
-		if (iterator_virtual != vm_to_update)
-			population_line_after[iterator_virtual] = actual_population_line[iterator_virtual];
-		else
-			population_line_after[iterator_virtual] = h_to_update;
-	}
+	float cm_after;
 
-	for (iterator_virtual = 0; iterator_virtual < v_size; iterator_virtual++)
-	{
-		// VM with no CRITICAL_SERVICES
-		if (V[iterator_virtual][3] != CRITICAL_SERVICES)
-		{
-			if (population_line_after[iterator_virtual] != 0)
-			{
-				// Only change the Commitment Level if the PM was not set with Critical Services
-				if (cm_line_after[(population_line_after[iterator_virtual])-1] != cl_cs)
-					cm_line_after[population_line_after[iterator_virtual]-1] = cl_nc;
-			}
-		}
-		// VM with CRITICAL_SERVICES
-		else
-		{
-			if (population_line_after[iterator_virtual] != 0)
-				cm_line_after[ (population_line_after[iterator_virtual]) - 1 ] = cl_cs;
-		}
-	}
+	/* the PM that receives the VM hosts critical services after the migration if the VM or any VM already there has them */
+	if (V[3][vm_to_update] == CRITICAL_SERVICES || PHYSICAL_EVALUATION(population, individual, h_to_update-1)->critical_vms > 0)
+		cm_after = context->cl_cs;
+	else
+		cm_after = context->cl_nc;
 
 	/* 	If the future commitment calculation found to the PM that will receive the VM is bigger or equal to the current,
 		that means can migrate (returns 1), if not, means that the commitment that will be applied will be less than the
 		current, so you are trying to migrate a critical VM to a PM with only no critical VMs (returns 0).
 	*/
 
-	if (cm_line_after[h_to_update-1] >= actual_cm[individual_adjustment][h_to_update-1])
+	if (cm_after >= cm[individual][h_to_update-1])
 		return 1;
 	else
 		return 0;
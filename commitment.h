@@ -4,8 +4,9 @@
  * Author: Petrônio Carlos Bezerra (petroniocg@ifpb.edu.br)
 */
 
-extern float cl_cs;
-extern float cl_nc;
+#include "population.h"
+#include "context.h"
 
-float **calculates_commitment(int **population, int number_of_individuals, int h_size, int v_size, int **V, int CRITICAL_SERVICES);
-void update_commitment_line (int **population, float **cm, int **V, int individual_overloaded, int h_size, int v_size, int CRITICAL_SERVICES);
+float **calculates_commitment(struct vmpos_context *context, struct population *population, int number_of_individuals, int h_size, int v_size, int **V, int CRITICAL_SERVICES, struct arena *arena);
+float commitment_level(struct vmpos_context *context, struct population *population, int individual, int physical);
+int calculates_commitment_line(struct vmpos_context *context, struct population *population, float **cm, int **V, int individual, int vm_to_update, int h_to_update, int CRITICAL_SERVICES);
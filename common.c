@@ -13,97 +13,7 @@
 	
 /* include common header */
 #include "common.h"
-
-/* get_h_size: returns the number of physical machines
- * parameter: path to the datacenter file
- * returns: number of physical machines
-*/
-int get_h_size(char path_to_file[])
-{
-	/* datacenter file to read from */
-	FILE *datacenter_file;
-	/* line readed from file */
-	char input_line[TAM_BUFFER];
-	/* number of physical machines */
-	int h_size = 0;
-	/* 1 if reading the physical machines block in the file */
-	int reading_physical = 0;
- 	/* open the file for reading */ 
-	datacenter_file = fopen(path_to_file,"r");
-    /* if it is opened ok, we continue */    
-	if (datacenter_file != NULL) 
-	{ 
-		/* read until the end */
-		while(!feof(datacenter_file)) 
-		{
-			/* get line per line */
-			fgets(input_line, TAM_BUFFER, datacenter_file);
-			/* if the line is equal to H_HEADER, we begin the physical machines block in the file */
-			if (strstr(input_line,H_HEADER) != NULL)
-			{
-				reading_physical = 1;
-			}
-			/* if the line is equal to V_HEADER, we end the physical machines block in the file */
-			if (strstr(input_line,V_HEADER) != NULL) 
-			{
-				reading_physical = 0;
-				break;
-			}
-			/* if it is the correct block in the file, it is not the header and it is not a blank line, we count */			
-			if (reading_physical == 1 && strstr(input_line,H_HEADER) == NULL && strcmp(input_line, "\n") != 0)
-			{
-				h_size++;
-			}
-		}
-	}
-	/* close the file */
-	fclose(datacenter_file);
-	/* return the value */
-	return h_size;
-}
-
-/* get_v_size: returns the number of virtual machines
- * parameter: path to the datacenter file
- * returns: number of virtual machines
-*/
-int get_v_size(char path_to_file[])
-{
-	/* datacenter file to read from */
-	FILE *datacenter_file;
-	/* line readed from file */
-	char input_line[TAM_BUFFER];
-	/* number of virtual machines */
-	int v_size = 0;
-	/* 1 if reading the virtual machines block in the file */
-	int reading_virtual = 0;
- 	/* open the file for reading */
-	datacenter_file = fopen(path_to_file,"r");
-    /* if it is opened ok, we continue */
-	if (datacenter_file != NULL) 
-	{ 
-		/* read until the end */
-		while(!feof(datacenter_file)) 
-		{
-			/* get line per line */
-			fgets(input_line, TAM_BUFFER, datacenter_file);
-			/* if the line is equal to V_HEADER, we begin the virtual machines block in the file */
-			if (strstr(input_line,V_HEADER) != NULL)
-			{
-				reading_virtual = 1;
-			}
-
-			/* if we are in the correct block in the file, it is not the header and it is not a blank line, we count */
-			if (reading_virtual == 1 && strstr(input_line,V_HEADER) == NULL && strcmp(input_line, "\n") != 0)
-			{
-				v_size++;
-			}
-		}
-	}
-	/* close the file */
-	fclose(datacenter_file);
-	/* return the value */
-	return v_size;
-}
+#include "evaluation.h"
 
 /* print_int_matrix: prints on screen a integer matrix
  * parameter: matrix to print
@@ -200,123 +110,12 @@ void print_float_array(float *array, int columns)
 	}
 }
 
-/* load_H: load the values of H
- * parameter: number of physical machines
- * parameter: path to the datacenter file
- * returns: H matrix
-*/
-int** load_H(int h_size, char path_to_file[])
-{
-	/* datacenter file to read from */
-	FILE *datacenter_file;
-	/* line readed from file */
-	char input_line[TAM_BUFFER];
-	/* iterator */
-	int iterator = 0;
-	/* 1 if is reading the physical machines block in the file */
-	int reading_physical = 0;
-	/* memory reserve for h_size physical machines */
-	int **H = (int **) malloc (h_size *sizeof (int *));
- 	/* open the file for reading */ 
-	datacenter_file = fopen(path_to_file,"r");
-    /* if it is opened ok, we continue */    
-	if (datacenter_file != NULL) 
-	{ 
-		/* read until the end */
-		while(!feof(datacenter_file)) 
-		{
-			/* get line per line */
-			fgets(input_line, TAM_BUFFER, datacenter_file);
-			/* if the line is equal to H_HEADER, we begin the physical machines block in the file */
-			if (strstr(input_line,H_HEADER) != NULL)
-			{
-				reading_physical = 1;
-			}
-			/* if the line is equal to V_HEADER, we end the physical machines block in the file */
-			if (strstr(input_line,V_HEADER) != NULL) 
-			{
-				reading_physical = 0;
-				break;
-			}
-			/* if it's the correct block in the file, it is not the header and it is not a blank line, we count */			
-			if (reading_physical == 1 && strstr(input_line,H_HEADER) == NULL && strcmp(input_line, "\n") != 0)
-			{
-				/* reserve 4 columns for Processor, Memory, Storage and Power Consumption */
-				H[iterator] = (int *) malloc (4 *sizeof (int));
-				/* load on the matrix and increment iterator */
-				sscanf(input_line,"%d %d %d %d\n",&H[iterator][0],&H[iterator][1],&H[iterator][2],&H[iterator][3]);
-				iterator++;
-			}
-		}
-	}
-	fclose(datacenter_file);
-	return H;
-}
-
-/* load_V: load the values of V
- * parameter: number of virtual machines
- * parameter: path to the datacenter file
- * returns: V matrix
-*/
-int** load_V(int v_size, char path_to_file[], int CRITICAL_SERVICES)
-{
-	/* datacenter file to read from */
-	FILE *datacenter_file;
-	FILE *pareto_result;
-	/* line readed from file */
-	char input_line[TAM_BUFFER];
-	/* iterator */
-	int iterator = 0;
-	/* 1 if is reading the virtual machines block in the file */
-	int reading_virtual = 0;
-	/* memory reserve for v_size virtual machines */
-	int **V = (int **) malloc (v_size *sizeof (int *));
- 	/* open the file for reading */ 
-	datacenter_file = fopen(path_to_file,"r");
-    /* if it is opened ok, we continue */    
-	if (datacenter_file != NULL) 
-	{ 
-		/* read until the end */
-		while(!feof(datacenter_file)) 
-		{
-			/* get line per line */
-			fgets(input_line, TAM_BUFFER, datacenter_file);
-			/* if the line is equal to V_HEADER, we begin the virtual machines block in the file */
-			if (strstr(input_line,V_HEADER) != NULL)
-			{
-				reading_virtual = 1;
-			}
-
-			/* if it's the correct block in the file, it is not the header and it is not a blank line, we count */			
-			if (reading_virtual == 1 && strstr(input_line,V_HEADER) == NULL && strcmp(input_line, "\n") != 0)
-			{
-				/* reserve 4 columns for Processor, Memory, Storage and Flag for Critical Service */
-				V[iterator] = (int *) malloc (4 *sizeof (int));
-				sscanf(input_line,"%d %d %d %d\n",&V[iterator][0],&V[iterator][1],&V[iterator][2],&V[iterator][3]);
-
-				//Petronio: Nivel de Dispersao
-				if (V[iterator][3] == CRITICAL_SERVICES)
-					number_vms_sc++;
-
-				iterator++;
-			}
-		}
-	}
-	fclose(datacenter_file);
-
-	pareto_result = fopen("results/pareto_result","a");
-	fprintf(pareto_result,"\nNumber of CRITICAL VMs: %d (%.1f%%)\n\n", number_vms_sc, ((float)number_vms_sc/(float)v_size)*100.0);
-	fclose(pareto_result);
-
-	return V;
-}
-
-
 /* load_dc_config: load the values of DC configuration
- * parameter: path to the datacenter file
+ * parameter: solver context, where the values are loaded
+ * parameter: path to the configuration file
  * returns: nothing, it's void
 */
-void load_dc_config()
+void load_dc_config(struct vmpos_context *context, char path_to_file[])
 {
 	/* datacenter file to read from */
 	FILE *datacenter_cfg_file;
@@ -328,19 +127,20 @@ void load_dc_config()
 	int reading_objectives = 0;
 	int reading_commitments = 0;
 	int reading_vms_config = 0;
+	int reading_archive = 0;
+	int reading_threads = 0;
+	int reading_mutation = 0;
+	int reading_islands = 0;
 
  	/* open the file for reading */ 
-	datacenter_cfg_file = fopen("vmpos_config.vmp","r");
+	datacenter_cfg_file = fopen(path_to_file,"r");
 
     /* if it is opened ok, we continue */    
 	if (datacenter_cfg_file != NULL)
 	{ 
-		/* read until the end */
-		while(!feof(datacenter_cfg_file))
+		/* read until the end, get line per line */
+		while(fgets(input_line, TAM_BUFFER, datacenter_cfg_file) != NULL)
 		{
-			/* get line per line */
-			fgets(input_line, TAM_BUFFER, datacenter_cfg_file);
-
 			/* if the line is equal to POPULATION, we begin the population configuration block */
 			if (strstr(input_line,"POPULATION") != NULL)
 			{
@@ -371,39 +171,111 @@ void load_dc_config()
 				reading_commitments = 0;
 				reading_vms_config = 1;
 			}
+			/* if the line is equal to ARCHIVE SIZE, we end the MIGRATION COSTS block and we begin the optional archive configuration block */
+			if (strstr(input_line,"ARCHIVE SIZE") != NULL) 
+			{
+				reading_population = 0;
+				reading_objectives = 0;
+				reading_commitments = 0;
+				reading_vms_config = 0;
+				reading_archive = 1;
+				reading_threads = 0;
+				reading_mutation = 0;
+				reading_islands = 0;
+			}
+			/* if the line is equal to THREADS, we begin the optional threads configuration block */
+			if (strstr(input_line,"THREADS") != NULL) 
+			{
+				reading_population = 0;
+				reading_objectives = 0;
+				reading_commitments = 0;
+				reading_vms_config = 0;
+				reading_archive = 0;
+				reading_threads = 1;
+				reading_mutation = 0;
+				reading_islands = 0;
+			}
+			/* if the line is equal to MUTATION RATE, we begin the optional mutation configuration block */
+			if (strstr(input_line,"MUTATION RATE") != NULL) 
+			{
+				reading_population = 0;
+				reading_objectives = 0;
+				reading_commitments = 0;
+				reading_vms_config = 0;
+				reading_archive = 0;
+				reading_threads = 0;
+				reading_mutation = 1;
+				reading_islands = 0;
+			}
+			/* if the line is equal to ISLANDS, we begin the optional island model configuration block */
+			if (strstr(input_line,"ISLANDS") != NULL)
+			{
+				reading_population = 0;
+				reading_objectives = 0;
+				reading_commitments = 0;
+				reading_vms_config = 0;
+				reading_archive = 0;
+				reading_threads = 0;
+				reading_mutation = 0;
+				reading_islands = 1;
+			}
 
 			/* if it's the correct block in the file, it is not the header and it is not a blank line, we read */			
 			if (reading_population == 1 && strstr(input_line,"POPULATION") == NULL && strcmp(input_line, "\n") != 0)
 			{
 				/* load on the population and increment iterator */
-				sscanf(input_line,"%d %d",&total_of_individuals, &total_of_generations);
+				sscanf(input_line,"%d %d",&context->total_of_individuals, &context->total_of_generations);
 			}
 
 			if (reading_objectives == 1 && strstr(input_line,"OBJECTIVES WEIGHT") == NULL && strcmp(input_line, "\n") != 0)
 			{
 				/* load objectives values */
-				sscanf(input_line,"%f %f %f",&energy_objective_weight, &dispersion_objective_weight, &migration_objective_weight);
+				sscanf(input_line,"%f %f %f",&context->energy_objective_weight, &context->dispersion_objective_weight, &context->migration_objective_weight);
 			}
 
 			if (reading_commitments == 1 && strstr(input_line,"COMMITMENT LEVEL") == NULL && strcmp(input_line, "\n") != 0)
 			{
 				/* load commitment parameters values */
-				sscanf(input_line,"%f %f", &cl_cs, &cl_nc);
+				sscanf(input_line,"%f %f", &context->cl_cs, &context->cl_nc);
 			}
 			if (reading_vms_config == 1 && strstr(input_line,"MIGRATION COSTS") == NULL && strcmp(input_line, "\n") != 0)
 			{
 				/* load VMs costs parameters values */
-				sscanf(input_line,"%f %f", &mc_cs, &mc_ncs);
-				break;
+				sscanf(input_line,"%f %f", &context->mc_cs, &context->mc_ncs);
+			}
+			if (reading_archive == 1 && strstr(input_line,"ARCHIVE SIZE") == NULL && strcmp(input_line, "\n") != 0)
+			{
+				/* load the maximum number of solutions of the Pareto archive, 0 for no maximum */
+				sscanf(input_line,"%d", &context->archive_max_size);
+			}
+			if (reading_threads == 1 && strstr(input_line,"THREADS") == NULL && strcmp(input_line, "\n") != 0)
+			{
+				/* load the number of threads of the offspring pipeline, 0 for one per processor */
+				sscanf(input_line,"%d", &context->number_of_threads);
+			}
+			if (reading_mutation == 1 && strstr(input_line,"MUTATION RATE") == NULL && strcmp(input_line, "\n") != 0)
+			{
+				/* load the probability of mutation of each virtual machine, 0 for 1/v_size */
+				sscanf(input_line,"%f", &context->mutation_rate);
+			}
+			if (reading_islands == 1 && strstr(input_line,"ISLANDS") == NULL && strcmp(input_line, "\n") != 0)
+			{
+				/* load the number of islands, the generations between migrations, the migrants of each island and the topology */
+				sscanf(input_line,"%d %d %d %d", &context->number_of_islands, &context->migration_interval, &context->number_of_migrants, &context->migration_topology);
 			}
 		}
-	}
 
-	fclose(datacenter_cfg_file);
+		fclose(datacenter_cfg_file);
+	}
 }
 
-
-int read_base_solution(int lenght)
+/* read_base_solution: reads the base solution of the migration cost objective
+ * parameter: solver context, where the base solution is kept
+ * parameter: path to the base individual file
+ * parameter: number of virtual machines
+ * returns: number of VMs allocated in the base solution, 0 if the file could not be read
+*/
+int read_base_solution(struct vmpos_context *context, char path_to_file[], int lenght)
 {
 	int i = 0;
 
@@ -411,89 +283,102 @@ int read_base_solution(int lenght)
 	FILE *base_file;
 
  	/* open the file for reading */ 
-	base_file = fopen("vmpos_base_individual.vmp","r");
+	base_file = fopen(path_to_file,"r");
 
-	base_solution = (int*) malloc( lenght * sizeof(int) );
-	
 	if (base_file == NULL)
 	{
 		printf("\n[WARNING]: Could not open the file with the base individual. Or, there is no such file.\n");
+		context->readed_solution = 0;
 		return(0);
 	}
 
-	while( ( fscanf(base_file,"%d", &base_solution[i]) ) != EOF )
-		if (base_solution[i] > 0)
+	free(context->base_solution);
+	context->base_solution = (int*) malloc( lenght * sizeof(int) );
+
+	while( i < lenght && ( fscanf(base_file,"%d", &context->base_solution[i]) ) != EOF )
+		if (context->base_solution[i] > 0)
 			i++;
 
+	fclose(base_file);
+
+	context->readed_solution = i;
+
 	return i;
 }
 
+/* open_result_file: opens a report file of the results directory of the context for appending
+ * parameter: solver context
+ * parameter: name of the file
+ * returns: the file, NULL if the context has no results directory
+*/
+FILE *open_result_file(struct vmpos_context *context, const char *name)
+{
+	char path_to_file[TAM_BUFFER];
+
+	if (context->results_directory == NULL)
+		return NULL;
+
+	snprintf(path_to_file, sizeof (path_to_file), "%s/%s", context->results_directory, name);
+
+	return fopen(path_to_file, "a");
+}
+
 
 
 /* load_utilization: loads the utilization of the physical machines of all the individuals
- * parameter: population matrix
+ * parameter: population, its utilization block is reserved in the first call and reused after
  * parameter: physical machines matrix
  * parameter: virtual machines matrix
  * parameter: number of individuals
  * parameter: number of physical machines
  * parameter: number of virtual machines
- * returns: utilization tridimentional matrix
+ * returns: nothing, it's void
 */
-int ***load_utilization(int **population, int **H, int **V, int number_of_individuals, int h_size, int v_size)
+void load_utilization(struct population *population, int **H, int **V, int number_of_individuals, int h_size, int v_size)
 {
 	/* iterators */
 	int iterator_individual;
 	int iterator_virtual;
-	int iterator_physical;
+	int *individual;
+	/* utilization of the physical machine of a virtual machine */
+	int *utilization;
+
 	/* utilization holds the physical machines utilization of Processor, Memory and Storage of every individual */
-	int ***utilization = (int ***) malloc (number_of_individuals *sizeof (int **));
-	/* iterate on individuals */	
-	for (iterator_individual=0; iterator_individual < number_of_individuals; iterator_individual++)
+	if (population->utilization == NULL || population->h_size != h_size)
 	{
-		/* requirements matrix, holds the sum of virtual machines requirements for each physical machine */
-		int **requirements = (int **) malloc (h_size *sizeof (int *));
-		/* utilization holds the physical machines utilization of Processor, Memory and Storage of every individual */
-		utilization[iterator_individual] = (int **) malloc (h_size *sizeof (int *));
-		for (iterator_physical=0; iterator_physical < h_size; iterator_physical++)
-		{
-			/* virtual machine requirements in Processor, Memory and Storage. Initialized to 0 */
-			requirements[iterator_physical] = (int *) malloc (3 *sizeof (int));
- 			requirements[iterator_physical][0] = requirements[iterator_physical][1] = requirements[iterator_physical][2] = 0;
-			/* physical machine utilization of Processor, Memory and Storage. Initialized to 0 */
-			utilization[iterator_individual][iterator_physical] = (int *) malloc (3 *sizeof (int));
-			utilization[iterator_individual][iterator_physical][0] = utilization[iterator_individual][iterator_physical][1] = 
-			utilization[iterator_individual][iterator_physical][2] = 0;
-		}
+		if (population->arena == NULL)
+			free(population->utilization);
+		population->utilization = (int *) arena_alloc (population->arena, ((size_t) population->number_of_individuals * h_size * 3 + 1) *sizeof (int));
+		population->h_size = h_size;
+	}
+
+	/* physical machine utilization of Processor, Memory and Storage. Initialized to 0 */
+	memset(population->utilization, 0, (size_t) number_of_individuals * h_size * 3 *sizeof (int));
 
+	/* iterate on individuals */
+	for (iterator_individual=0; iterator_individual < number_of_individuals; iterator_individual++)
+	{
 		/* iterate on positions of an individual */
+		individual = INDIVIDUAL(population, iterator_individual);
 		for (iterator_virtual = 0; iterator_virtual < v_size; iterator_virtual++)
 		{
 			/* if the virtual machine has a placement assigned */
-			if (population[iterator_individual][iterator_virtual] != 0)
+			if (individual[iterator_virtual] != 0)
 			{
-				/* increment the requirements of the assigned physical machine with the virtual machine requirements
+				/* increment the utilization of the assigned physical machine with the virtual machine requirements
 				of Processor, Memory and Storage */
-				requirements[population[iterator_individual][iterator_virtual]-1][0] += V[iterator_virtual][0];
-				requirements[population[iterator_individual][iterator_virtual]-1][1] += V[iterator_virtual][1];
-				requirements[population[iterator_individual][iterator_virtual]-1][2] += V[iterator_virtual][2];
+				utilization = UTILIZATION(population, iterator_individual, individual[iterator_virtual]-1);
+				utilization[0] += V[0][iterator_virtual];
+				utilization[1] += V[1][iterator_virtual];
+				utilization[2] += V[2][iterator_virtual];
 			}
 		}
-
-		/* iterate on positions of an individual */
-		for (iterator_physical=0; iterator_physical < h_size; iterator_physical++)
-		{
-			/* virtual machine requirements in Processor, Memory and Storage. Initialized to 0 */
-			utilization[iterator_individual][iterator_physical][0] = requirements[iterator_physical][0];
-			utilization[iterator_individual][iterator_physical][1] = requirements[iterator_physical][1];
-			utilization[iterator_individual][iterator_physical][2] = requirements[iterator_physical][2];
-		}
 	}
-	return utilization;
 }
 
 /* load_objectives: calculate the cost of each objective of each solution
- * parameter: population matrix
- * parameter: utilization tridimentional matrix
+ * parameter: solver context
+ * parameter: population, with its utilization loaded. If its evaluation is loaded, the costs are read from the partial sums
  * parameter: commitment matrix
  * parameter: physical machines matrix
  * parameter: virtual machines matrix
@@ -501,12 +386,14 @@ int ***load_utilization(int **population, int **H, int **V, int number_of_indivi
  * parameter: number of physical machines
  * parameter: number of virtual machines
  * parameter: base_solution individual
+ * parameter: arena to take the matrix from, or NULL to use malloc (the rows are one block, value_solution[0])
  * returns: cost of each objetive matrix
 */
-float **load_objectives(int **population, int ***utilization, float **cm, int **H, int **V, int number_of_individuals, int h_size, int v_size, int* base_solution, int CRITICAL_SERVICES)
+float **load_objectives(struct vmpos_context *context, struct population *population, float **cm, int **H, int **V, int number_of_individuals, int h_size, int v_size, int* base_solution, int CRITICAL_SERVICES, struct arena *arena)
 {
 	/* iterators */
 	int iterator_individual;
+	int *individual;
 	//int iterator_virtual2;
 	int iterator_virtual;
 	int physical_position;
@@ -521,11 +408,21 @@ float **load_objectives(int **population, int ***utilization, float **cm, int **
 	int found_critical, found_no_critical;
 	int total_pm_CS, total_pm_NCS, total_pm_ON;
 
-	/* value solution holds the cost of each solution */
-	float **value_solution = (float **) malloc (number_of_individuals *sizeof (float *));
+	/* value solution holds the cost of each solution, with all the rows in one block */
+	float **value_solution = (float **) arena_alloc (arena, number_of_individuals *sizeof (float *));
+	float *value_solution_data = (float *) arena_alloc (arena, ((size_t) number_of_individuals * 3 + 1) *sizeof (float));
 
 	for (iterator_individual = 0 ; iterator_individual < number_of_individuals; iterator_individual++)
-		value_solution[iterator_individual] = (float *) malloc (3 *sizeof (float));
+		value_solution[iterator_individual] = value_solution_data + (size_t) iterator_individual * 3;
+
+	/* the partial sums are kept up to date by move_virtual_machine, there is nothing to recalculate */
+	if (population->evaluation != NULL)
+	{
+		for (iterator_individual = 0; iterator_individual < number_of_individuals; iterator_individual++)
+			evaluation_objectives(context, population, iterator_individual, v_size, value_solution[iterator_individual]);
+
+		return value_solution;
+	}
 
 	/* iterate on individuals */
 	for (iterator_individual = 0; iterator_individual < number_of_individuals; iterator_individual++)
@@ -537,29 +434,31 @@ float **load_objectives(int **population, int ***utilization, float **cm, int **
 
 		total_pm_CS = total_pm_NCS = total_pm_ON = 0;
 
+		individual = INDIVIDUAL(population, iterator_individual);
+
 		/* (OF1 - Objective Function 1) calculate energy consumption of each solution*/
 		/* iterate on physical machines */
 		for (iterator_physical = 0 ; iterator_physical < h_size ; iterator_physical++)
 		{
-			if (utilization[iterator_individual][iterator_physical][0] > 0)
+			if (UTILIZATION(population, iterator_individual, iterator_physical)[0] > 0)
 			{
 				/* calculates utility of a physical machine */
-				utilidad = (float) utilization[iterator_individual][iterator_physical][0] / ( (float) H[iterator_physical][0] * cm[iterator_individual][iterator_physical] );
+				utilidad = (float) UTILIZATION(population, iterator_individual, iterator_physical)[0] / ( (float) H[0][iterator_physical] * cm[iterator_individual][iterator_physical] );
 				
 				/* calculates energy consumption of a physical machine */
-				power_consumption += ( (float) H[iterator_physical][3] - ( (float) H[iterator_physical][3] * 0.6) ) * utilidad + 
-				( (float) H[iterator_physical][3] * 0.6 );
+				power_consumption += ( (float) H[3][iterator_physical] - ( (float) H[3][iterator_physical] * 0.6) ) * utilidad + 
+				( (float) H[3][iterator_physical] * 0.6 );
 
 				found_critical = found_no_critical = 0;
 				total_pm_ON++;
 
-				if (cl_cs == cl_nc)
+				if (context->cl_cs == context->cl_nc)
 				{
 					for (iterator_virtual = 0; iterator_virtual < v_size; iterator_virtual++)
 					{
-						if (population[iterator_individual][iterator_virtual]-1 == iterator_physical)
+						if (individual[iterator_virtual]-1 == iterator_physical)
 						{
-							if ( V[iterator_virtual][3] == CRITICAL_SERVICES )
+							if ( V[3][iterator_virtual] == CRITICAL_SERVICES )
 								found_critical++;
 							else
 								found_no_critical++;
@@ -575,13 +474,13 @@ float **load_objectives(int **population, int ***utilization, float **cm, int **
 				}
 				else
 				{
-					if (cm[iterator_individual][iterator_physical] == cl_cs)
+					if (cm[iterator_individual][iterator_physical] == context->cl_cs)
 					{
 						total_pm_CS++;
 
 						for (iterator_virtual = 0; iterator_virtual < v_size; iterator_virtual++)
 							/* verify if there is a no critical VM on PM */
-							if ( (population[iterator_individual][iterator_virtual]-1 == iterator_physical) && V[iterator_virtual][3] != CRITICAL_SERVICES)
+							if ( (individual[iterator_virtual]-1 == iterator_physical) && V[3][iterator_virtual] != CRITICAL_SERVICES)
 							{
 								total_pm_NCS++;
 								break;
@@ -599,18 +498,18 @@ float **load_objectives(int **population, int ***utilization, float **cm, int **
 		/* (OF2) calculate the Dispersion Level of each solution */
 		if(total_pm_CS != 0 && total_pm_NCS != 0)
 		{
-			value_solution[iterator_individual][1] = ( (float)total_pm_CS / ( ((float)number_vms_sc/(float)total_pm_CS) + ( ((float)v_size - (float)number_vms_sc) / total_pm_NCS ) ) );
+			value_solution[iterator_individual][1] = ( (float)total_pm_CS / ( ((float)context->number_vms_sc/(float)total_pm_CS) + ( ((float)v_size - (float)context->number_vms_sc) / total_pm_NCS ) ) );
 		}
 		else
 		{
 			if(total_pm_CS == 0)
-				value_solution[iterator_individual][1] = ((float)(v_size - (float)number_vms_sc) / (float)total_pm_NCS);
+				value_solution[iterator_individual][1] = ((float)(v_size - (float)context->number_vms_sc) / (float)total_pm_NCS);
 			else
-				value_solution[iterator_individual][1] = ((float) number_vms_sc / (float)total_pm_CS);
+				value_solution[iterator_individual][1] = ((float) context->number_vms_sc / (float)total_pm_CS);
 		}
 
 		/* (OF3) calculate migration cost of each solution */
-		value_solution[iterator_individual][2] = migration_cost (V, base_solution, population[iterator_individual], v_size, CRITICAL_SERVICES);
+		value_solution[iterator_individual][2] = migration_cost (context, V, base_solution, individual, v_size, CRITICAL_SERVICES);
 	}
 
 	return value_solution;
@@ -618,13 +517,14 @@ float **load_objectives(int **population, int ***utilization, float **cm, int **
 
 
 /* migration_cost: calculates the migration cost of a solution
+ * parameter: solver context
  * parameter: virtual machines matrix
  * parameter: base_solution individual
  * parameter: population individual vector
  * parameter: number of virtual machines
  * returns: cost of migration to change VMs positions from base_individual to individ
 */
-float migration_cost (int **vm, int *b_solution, int *individ, int v_size, int CRITICAL_SERVICES)
+float migration_cost (struct vmpos_context *context, int **vm, int *b_solution, int *individ, int v_size, int CRITICAL_SERVICES)
 {
 	int iter_virt, total_critical_vms = 0, total_no_critical_vms = 0;
 	float sum = 0.0;
@@ -633,26 +533,26 @@ float migration_cost (int **vm, int *b_solution, int *individ, int v_size, int C
 	{
 		if (b_solution[iter_virt] != individ[iter_virt])
 		{
-			if (vm[iter_virt][3] == CRITICAL_SERVICES)
+			if (vm[3][iter_virt] == CRITICAL_SERVICES)
 				total_critical_vms++;
 			else
 				total_no_critical_vms++;
 		}
 	}
 
-	sum = (float)(total_critical_vms * mc_cs) + (float)(total_no_critical_vms * mc_ncs);	
+	sum = (float)(total_critical_vms * context->mc_cs) + (float)(total_no_critical_vms * context->mc_ncs);	
 
 	return sum;
 }
 
 
 /* generate_base_solution: copy the random base_solution generated in initial population, to be used in migration cost objective
- * parameter: population matrix
+ * parameter: population
  * parameter: number of individuals
  * parameter: number of virtual machines
  * returns: the base_individual
 */
-int *generate_base_solution(int **population, int v_size, int number_of_individuals)
+int *generate_base_solution(struct population *population, int v_size, int number_of_individuals)
 {
 	/* iterators */
 	int iterator_virtual;	
@@ -661,19 +561,20 @@ int *generate_base_solution(int **population, int v_size, int number_of_individu
 
 	for (iterator_virtual = 0 ; iterator_virtual < v_size ; iterator_virtual++)
 		/* Copy the extra individual generated in population to base individual */
-		base_s[iterator_virtual] = population[number_of_individuals][iterator_virtual];
+		base_s[iterator_virtual] = INDIVIDUAL(population, number_of_individuals)[iterator_virtual];
 
 	return base_s;
 }
 
 
 /* update_pm_used_in_individual: counts the number of PM used in an individual
+ * parameter: solver context
  * parameter: the individual
  * parameter: number of physical machines
  * parameter: number of virtual machines
- * returns: nothing, it's void
+ * returns: number of PM used by the global best individual
 */
-void update_pm_used_in_individual (int individual, int h_size, int v_size)
+int update_pm_used_in_individual (struct vmpos_context *context, int individual, int h_size, int v_size)
 {
 	int iterator_virtual, iterator_physical;
 	
@@ -683,7 +584,7 @@ void update_pm_used_in_individual (int individual, int h_size, int v_size)
 	{
 		for (iterator_virtual=0; iterator_virtual < v_size; iterator_virtual++)
 		{
-			if (global_best_individual[iterator_virtual] == iterator_physical + 1)
+			if (context->global_best_individual[iterator_virtual] == iterator_physical + 1)
 			{
 				pm_used_in_individual++;
 				break;
@@ -691,5 +592,9 @@ void update_pm_used_in_individual (int individual, int h_size, int v_size)
 		}
 	}
 
-	global_h_sizes[individual] = pm_used_in_individual;
+	/* the individual comes from the pareto set, that can be bigger than global_h_sizes */
+	if (individual < context->total_of_individuals)
+		context->global_h_sizes[individual] = pm_used_in_individual;
+
+	return pm_used_in_individual;
 }
@@ -17,6 +17,9 @@
 #include <math.h>
 #include <time.h>
 
+#include "population.h"
+#include "context.h"
+
 /* definitions */
 #define H_HEADER "PHYSICAL MACHINES"
 #define V_HEADER "VIRTUAL MACHINES"
@@ -24,28 +27,11 @@
 #define CONSTANT 10000
 #define BIG_COST 1000000
 
-extern float mc_cs;
-extern float mc_ncs;
-
-extern int number_vms_sc;
-extern int *global_best_individual;
-extern int *base_solution;
-extern int *global_h_sizes;
-
-extern int total_of_individuals;
-extern int total_of_generations;
-extern float cl_cs;
-extern float cl_nc;
-extern float energy_objective_weight;
-extern float dispersion_objective_weight;
-extern float migration_objective_weight;
+/* H and V are stored by columns: H[resource][physical] and V[requirement][virtual] */
 
-void load_dc_config();
-int read_base_solution(int lenght);
-
-/* get the number of physical and virtual machines */
-int get_h_size(char path_to_file[]);
-int get_v_size(char path_to_file[]);
+void load_dc_config(struct vmpos_context *context, char path_to_file[]);
+int read_base_solution(struct vmpos_context *context, char path_to_file[], int lenght);
+FILE *open_result_file(struct vmpos_context *context, const char *name);
 
 /* print matrix and array functions */
 void print_int_matrix(int ** matrix, int rows, int columns);
@@ -54,13 +40,9 @@ void print_int_array(int * array, int columns);
 void print_int_array_line(int *array, int columns);
 void print_float_array(float * array, int columns);
 
-/* load datacenter physical resources and virtual requirements */
-int** load_H(int h_size, char path_to_file[]);
-int** load_V(int v_size, char path_to_file[], int CRITICAL_SERVICES);
-
 /* load utilization of physical resources and costs of the considered objective functions */
-int*** load_utilization(int **population, int **H, int **V, int number_of_individuals, int h_size, int v_size);
-float** load_objectives(int **population, int ***utilization, float **cm, int **H, int **V, int number_of_individuals, int h_size, int v_size, int* base_solution, int CRITICAL_SERVICES);
-float migration_cost (int **vm, int *b_solution, int *individ, int v_size, int CRITICAL_SERVICES);
-int* generate_base_solution(int **population, int v_size, int number_of_individuals);
-void update_pm_used_in_individual (int individual, int h_size, int v_size);
+void load_utilization(struct population *population, int **H, int **V, int number_of_individuals, int h_size, int v_size);
+float** load_objectives(struct vmpos_context *context, struct population *population, float **cm, int **H, int **V, int number_of_individuals, int h_size, int v_size, int* base_solution, int CRITICAL_SERVICES, struct arena *arena);
+float migration_cost (struct vmpos_context *context, int **vm, int *b_solution, int *individ, int v_size, int CRITICAL_SERVICES);
+int* generate_base_solution(struct population *population, int v_size, int number_of_individuals);
+int update_pm_used_in_individual (struct vmpos_context *context, int individual, int h_size, int v_size);
@@ -0,0 +1,338 @@
+/*
+ * context.c: Virtual Machine Placement with OverSubscription Problem - Solver Context
+ * Date: 17-10-2026
+ *
+ * A solve runs the Interactive Memetic Algorithm with Over Subscription with the state of one
+ * context. The islands and the Pareto archive of a solve are kept in the context until the next
+ * solve or until the context is destroyed, so the caller can read the front.
+*/
+
+/* include solver context header */
+#include "context.h"
+#include "common.h"
+#include "initialization.h"
+#include "pareto.h"
+#include "thread_pool.h"
+#include "island.h"
+
+/* context_memory: malloc that finishes the program if there is no memory
+ * parameter: size in bytes
+ * returns: the reserved memory
+*/
+static void *context_memory(size_t size)
+{
+	void *memory = malloc (size);
+
+	if (memory == NULL)
+	{
+		printf ("[ERROR]: Problem with memory space. Function malloc returned NULL!\n");
+		exit (EXIT_FAILURE);
+	}
+	return memory;
+}
+
+/* vmpos_create: creates a solver context for a datacenter, with the default configuration
+ * parameter: datacenter, it is not copied and it must live as long as the context
+ * parameter: if the VMs run critical services
+ * returns: solver context
+*/
+struct vmpos_context *vmpos_create(struct datacenter *datacenter, int CRITICAL_SERVICES)
+{
+	struct vmpos_context *context = (struct vmpos_context *) context_memory (sizeof (struct vmpos_context));
+
+	memset(context, 0, sizeof (struct vmpos_context));
+
+	context->number_of_islands = 1;
+	context->migration_interval = 10;
+	context->number_of_migrants = 1;
+	context->migration_topology = RING_TOPOLOGY;
+	context->seed = (unsigned long long) time(NULL);
+
+	context->datacenter = datacenter;
+	context->number_vms_sc = datacenter->number_vms_sc;
+	context->CRITICAL_SERVICES = CRITICAL_SERVICES;
+
+	context->generations_without_improvment = -1;
+	context->global_best_individual_cost = BIG_COST;
+	context->global_best_individual = (int *) context_memory (datacenter->v_size * sizeof (int));
+
+	return context;
+}
+
+/* free_solve: frees the islands and the Pareto archive of the last solve
+ * parameter: solver context
+ * returns: nothing, it's void
+*/
+static void free_solve(struct vmpos_context *context)
+{
+	int iterator_island;
+
+	if (context->islands == NULL)
+		return;
+
+	/* with more than one island the archive is the merge of the archives of the islands */
+	if (context->pareto_archive != context->islands[0]->archive)
+		free_pareto_archive(context->pareto_archive);
+
+	for (iterator_island = 0; context->islands[iterator_island] != NULL; iterator_island++)
+		free_island(context->islands[iterator_island]);
+
+	free(context->islands);
+	context->islands = NULL;
+	context->pareto_archive = NULL;
+	context->global_h_sizes = NULL;
+}
+
+/* report_configuration: writes the configuration of the solve in the report
+ * parameter: solver context
+ * returns: nothing, it's void
+*/
+static void report_configuration(struct vmpos_context *context)
+{
+	int h_size = context->datacenter->h_size;
+	int v_size = context->datacenter->v_size;
+	float mutation_rate = context->mutation_rate > 0.0 ? context->mutation_rate : 1.0 / v_size;
+	FILE *pareto_result = open_result_file(context, "pareto_result");
+
+	if (pareto_result == NULL)
+		return;
+
+	fprintf(pareto_result,"\nDATACENTER CONFIGURATION:\nNum of PMs: h_size = %d,\nNum of VMs: v_size = %d",h_size,v_size);
+	fprintf(pareto_result,"\nNumber of CRITICAL VMs: %d (%.1f%%)\n\n", context->number_vms_sc, ((float)context->number_vms_sc/(float)v_size)*100.0);
+
+	fprintf(pareto_result,"\nVMPOS CONFIGURATION PARAMETERS:\n");
+	fprintf(pareto_result,"Number of Individuals: %d\nNumber of Generations: %d\n",context->total_of_individuals, context->total_of_generations);
+	fprintf(pareto_result,"Energy Weight: %.3f\nDispersion Weight: %.3f\nMigration Weight: %.3f\n", context->energy_objective_weight, context->dispersion_objective_weight, context->migration_objective_weight);
+	fprintf(pareto_result,"Commitment Level for PM with VMs with Critical Services: %.1f\nCommitment Level for PM with VMs with NO Critical Services: %.1f\n", context->cl_cs, context->cl_nc);
+	fprintf(pareto_result,"Costs for VMs migrations: mc_cs = %.2f and mc_ncs = %.2f\n",context->mc_cs, context->mc_ncs);
+	if ( context->archive_max_size > 0 )
+		fprintf(pareto_result,"Maximum Archive Size: %d\n", context->archive_max_size);
+	if ( context->number_of_threads > 0 )
+		fprintf(pareto_result,"Number of Threads: %d\n", context->number_of_threads);
+	fprintf(pareto_result,"Mutation Rate: %g\n", mutation_rate);
+	fprintf(pareto_result,"Random Seed: %llu\n", context->seed);
+	if ( context->number_of_islands > 1 )
+		fprintf(pareto_result,"Islands: %d, migration of %d individuals every %d generations in a %s\n", context->number_of_islands, context->number_of_migrants, context->migration_interval, context->migration_topology == RANDOM_TOPOLOGY ? "random ring" : "ring");
+	if ( context->readed_solution )
+		fprintf(pareto_result,"Base Individual with %d VMs allocated in %d PM:\n", context->readed_solution, context->pm_used_in_base_individual);
+	fclose(pareto_result);
+}
+
+/* vmpos_set_base_solution: sets the base solution of the migration cost objective
+ * parameter: solver context
+ * parameter: PM of each VM, starting from 1, it is copied. NULL for a random base solution in each solve
+ * returns: number of VMs allocated in the base solution
+*/
+int vmpos_set_base_solution(struct vmpos_context *context, int *base_solution)
+{
+	int iterator_virtual;
+	int v_size = context->datacenter->v_size;
+
+	context->readed_solution = 0;
+
+	if (base_solution == NULL)
+		return 0;
+
+	if (context->base_solution == NULL)
+		context->base_solution = (int *) context_memory (v_size * sizeof (int));
+
+	for (iterator_virtual = 0; iterator_virtual < v_size; iterator_virtual++)
+	{
+		context->base_solution[iterator_virtual] = base_solution[iterator_virtual];
+		if (base_solution[iterator_virtual] > 0)
+			context->readed_solution++;
+	}
+
+	return context->readed_solution;
+}
+
+/* elapsed_seconds: seconds since a moment of the monotonic clock
+ * parameter: the moment
+ * returns: seconds
+*/
+static double elapsed_seconds(struct timespec *start)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	return (double) (now.tv_sec - start->tv_sec) + (double) (now.tv_nsec - start->tv_nsec) / 1e9;
+}
+
+/* vmpos_solve: runs the Interactive Memetic Algorithm with Over Subscription with the configuration of the context
+ * parameter: solver context. Without a base solution read, a random base solution is generated
+ * returns: 1 if the solve was done, 0 if the configuration is not valid. The generations done are in context->generation
+*/
+int vmpos_solve(struct vmpos_context *context)
+{
+	/* iterators */
+	int iterator_virtual, iterator_physical, iterator_island;
+
+	int h_size = context->datacenter->h_size;
+	int v_size = context->datacenter->v_size;
+	int **V = context->datacenter->V;
+	int initial_h_size, number_of_generations;
+	FILE *pareto_result;
+	struct timespec start;
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	PROFILE_START(timer);
+
+	/* the crossover needs two different parents */
+	if (context->total_of_individuals < 2 || context->total_of_generations < 0)
+		return 0;
+
+	if ( context->number_of_islands < 1 )
+		context->number_of_islands = 1;
+
+	if ( context->migration_interval < 1 )
+		context->migration_interval = 1;
+
+	/* the state of a previous solve is released */
+	free_solve(context);
+	context->generation = 0;
+	context->generations_without_improvment = -1;
+	context->global_best_individual_cost = BIG_COST;
+	context->best_generation = 0;
+	PROFILE_RESET(context);
+
+	for (iterator_virtual = 0; iterator_virtual < v_size; iterator_virtual++)
+		context->global_best_individual[iterator_virtual] = 0;
+
+	/* main stream of random numbers, the streams of the islands are split from it */
+	rng_seed(&context->rng, (uint64_t) context->seed);
+
+	if ( context->readed_solution )
+	{
+		/* P_0 uses only the PMs of the base solution */
+		initial_h_size = 0;
+	}
+	else
+	{
+		// A random individual is the base solution that will be used to compare
+		// with other solution in migration cost objective
+		struct population *base_population = initialization(1, h_size, v_size, V, context->CRITICAL_SERVICES, &context->rng, NULL);
+
+		free(context->base_solution);
+		context->base_solution = generate_base_solution(base_population, v_size, 0);
+		population_free(base_population);
+
+		/* P_0 uses all the PMs */
+		initial_h_size = h_size;
+	}
+
+	context->pm_used_in_base_individual = 0;
+
+	for (iterator_physical = 0; iterator_physical < h_size; iterator_physical++)
+	{
+		for (iterator_virtual=0; iterator_virtual < v_size; iterator_virtual++)
+		{
+			if (context->base_solution[iterator_virtual] == iterator_physical + 1)
+			{
+				context->pm_used_in_base_individual++;
+				break;
+			}
+		}
+	}
+
+	if ( initial_h_size == 0 )
+		initial_h_size = context->pm_used_in_base_individual;
+
+	report_configuration(context);
+
+	/* the workers of the offspring pipeline or of the islands, one per processor if the number is not configured */
+	context->thread_pool = thread_pool_create(context->number_of_threads > 0 ? context->number_of_threads : number_of_processors());
+
+	/* Interactive Memetic Algorithm with Over Subscription starts here */
+
+	/*******************************************/
+	/*    Initialize the populations P_0       */
+	/*******************************************/
+	/* the array of the islands ends with NULL */
+	context->islands = (struct island **) context_memory ((context->number_of_islands + 1) * sizeof (struct island *));
+
+	for (iterator_island = 0; iterator_island < context->number_of_islands; iterator_island++)
+		context->islands[iterator_island] = island_create(context, initial_h_size);
+	context->islands[context->number_of_islands] = NULL;
+
+	/* the PMs used by the individuals of the first island are counted in the report */
+	context->global_h_sizes = context->islands[0]->h_sizes;
+
+	/* Pc: with one island it is the archive of the island, with more it is the merge of the archives of all the islands */
+	if ( context->number_of_islands == 1 )
+		context->pareto_archive = context->islands[0]->archive;
+	else
+	{
+		context->pareto_archive = pareto_create(context, v_size, context->archive_max_size);
+		islands_merge(context->islands, context->number_of_islands, context->pareto_archive);
+	}
+
+	PROFILE_RESTART(timer);
+	report_best_population(context, context->pareto_archive, v_size, h_size);
+	PROFILE_LAP(context, PROFILE_REPORT, timer);
+
+	if ( context->generation_hook != NULL )
+		context->generation_hook(context, context->hook_data);
+
+	/* While (stopping criterion is not met), do */
+	while (context->generation < context->total_of_generations && (context->time_limit <= 0.0 || elapsed_seconds(&start) < context->time_limit) )
+	{
+		if ( context->number_of_islands == 1 )
+		{
+			/* this is a new generation! */
+			context->generation++;
+
+			/* the individuals of Q are processed by the thread pool */
+			island_generation(context->islands[0], context->thread_pool);
+		}
+		else
+		{
+			/* the generations until the next migration, each island in a thread of the pool */
+			number_of_generations = context->total_of_generations - context->generation;
+			if ( number_of_generations > context->migration_interval )
+				number_of_generations = context->migration_interval;
+
+			islands_evolution(context->thread_pool, context->islands, context->number_of_islands, number_of_generations);
+			context->generation += number_of_generations;
+
+			if ( context->generation < context->total_of_generations )
+				island_migration(context->islands, context->number_of_islands, context->number_of_migrants, context->migration_topology, &context->rng);
+
+			islands_merge(context->islands, context->number_of_islands, context->pareto_archive);
+		}
+
+		PROFILE_RESTART(timer);
+		report_best_population(context, context->pareto_archive, v_size, h_size);
+		PROFILE_LAP(context, PROFILE_REPORT, timer);
+
+		/* a line of the breakdown of the profile by generation */
+		PROFILE_GENERATION(context);
+
+		if ( context->generation_hook != NULL )
+			context->generation_hook(context, context->hook_data);
+	}
+
+	if ( (pareto_result = open_result_file(context, "pareto_result")) != NULL )
+	{
+		fprintf(pareto_result,"\nTotal of Generations to Generate: %d\nActual Generation: %d\nWithout Enhance the Best: %d\n\n", context->total_of_generations, context->generation, context->generations_without_improvment);
+		fclose(pareto_result);
+	}
+
+	thread_pool_free(context->thread_pool);
+	context->thread_pool = NULL;
+	PROFILE_FINISH(context);
+
+	return 1;
+}
+
+/* vmpos_destroy: frees a solver context, the datacenter is not freed
+ * parameter: solver context
+ * returns: nothing, it's void
+*/
+void vmpos_destroy(struct vmpos_context *context)
+{
+	free_solve(context);
+	free(context->global_best_individual);
+	free(context->base_solution);
+	free(context);
+}
@@ -0,0 +1,104 @@
+/*
+ * context.h: Virtual Machine Placement with OverSubscription Problem - Solver Context Header
+ * Date: 17-10-2026
+ *
+ * A context keeps all the state of a solve: the configuration of the algorithm, the datacenter,
+ * the base solution, the evolution of the best solution and the islands with their Pareto
+ * archives. Every function that needs this state receives the context, so several solves can
+ * run at the same time in one process, each one with its own context. This is the interface
+ * of the libvmpos library:
+ *
+ *     context = vmpos_create(&datacenter, CRITICAL_SERVICES);
+ *     load_dc_config(context, "vmpos_config.vmp");    (or set the configuration fields)
+ *     vmpos_set_base_solution(context, placement);     (optional, random if it is not given)
+ *     vmpos_solve(context);                            (the front is in context->pareto_archive)
+ *     vmpos_destroy(context);
+*/
+
+#ifndef CONTEXT_H
+#define CONTEXT_H
+
+#include "datacenter.h"
+#include "rng.h"
+#include "profile.h"
+
+struct pareto_archive;
+struct island;
+struct thread_pool;
+
+/* structure of a solver context */
+struct vmpos_context
+{
+	/* configuration of the algorithm, loaded from vmpos_config.vmp or set before the solve */
+	int total_of_individuals;
+	int total_of_generations;
+	float energy_objective_weight;
+	float dispersion_objective_weight;
+	float migration_objective_weight;
+	/* Commitment Level (CL) for PM hosting at least one VM with Critical Services (CS) and only VMs with NO Critical services (NC) */
+	float cl_cs;
+	float cl_nc;
+	/* Migration Cost of a VM with Critical Services and with No Critical Services */
+	float mc_cs;
+	float mc_ncs;
+	/* maximum number of solutions of the Pareto archive, 0 for no maximum */
+	int archive_max_size;
+	/* threads of the offspring pipeline or of the islands, 0 for one per processor */
+	int number_of_threads;
+	/* probability of mutation of each VM, 0 for 1/v_size */
+	float mutation_rate;
+	/* populations evolved apart, generations between two migrations, individuals sent by each island and topology */
+	int number_of_islands;
+	int migration_interval;
+	int number_of_migrants;
+	int migration_topology;
+	/* seed of the random numbers */
+	unsigned long long seed;
+	/* seconds a solve can run, it stops after the generation that reaches them. 0 for no limit */
+	double time_limit;
+	/* directory of the report files, NULL to write no report */
+	const char *results_directory;
+	/* file of the timeline of the solve in the Chrome Trace Event format, NULL for no trace. Only with -DVMPOS_PROFILE */
+	const char *trace_path;
+	/* 1 to read the hardware counters of the stages (cycles, instructions, cache and branch misses). Only with -DVMPOS_PROFILE */
+	int hardware_counters;
+	/* called after the first population and after every generation (or every migration, with islands), NULL for none */
+	void (*generation_hook)(struct vmpos_context *context, void *hook_data);
+	void *hook_data;
+
+	/* datacenter, not changed by the solve */
+	struct datacenter *datacenter;
+	int number_vms_sc;
+	int CRITICAL_SERVICES;
+
+	/* base solution for the migration cost objective, random if it is not read */
+	int *base_solution;
+	int readed_solution;
+	int pm_used_in_base_individual;
+
+	/* evolution of the best solution */
+	int generation;
+	int generations_without_improvment;
+	int best_generation;
+	float global_best_individual_cost;
+	int *global_best_individual;
+	float global_best_objective_functions[3];
+	/* number of PMs usable by each individual of the first island */
+	int *global_h_sizes;
+
+	/* state of the solve, kept after it for the Pareto front */
+	struct rng rng;
+	struct thread_pool *thread_pool;
+	struct island **islands;
+	struct pareto_archive *pareto_archive;
+	/* time of the stages and count of the hot operations, only with -DVMPOS_PROFILE */
+	struct profile profile;
+};
+
+/* function headers definitions */
+struct vmpos_context *vmpos_create(struct datacenter *datacenter, int CRITICAL_SERVICES);
+int vmpos_set_base_solution(struct vmpos_context *context, int *base_solution);
+int vmpos_solve(struct vmpos_context *context);
+void vmpos_destroy(struct vmpos_context *context);
+
+#endif
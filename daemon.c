@@ -0,0 +1,408 @@
+/*
+ * daemon.c: Virtual Machine Placement with OverSubscription Problem - Placement Daemon
+ * Date: 17-10-2026
+ *
+ * The clients are served one after the other, and a solve uses the thread pool of its context,
+ * so the daemon itself has only one thread. A model keeps its context between the requests:
+ * the configuration, the base placement and the front of the last solve.
+*/
+
+/* include libraries */
+#include <signal.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+/* include placement daemon header */
+#include "daemon.h"
+#include "common.h"
+#include "datacenter.h"
+#include "context.h"
+#include "pareto.h"
+
+/* structure of a model: a datacenter and its solver context, NULL if the model is free */
+struct daemon_model
+{
+	char name[DAEMON_NAME_SIZE];
+	struct datacenter datacenter;
+	struct vmpos_context *context;
+};
+
+/* find_model: searches a model by its name
+ * parameter: models
+ * parameter: name of the model
+ * returns: the model, NULL if there is no model with this name
+*/
+static struct daemon_model *find_model(struct daemon_model *models, char *name)
+{
+	int iterator_model;
+
+	if (name == NULL)
+		return NULL;
+
+	for (iterator_model = 0; iterator_model < DAEMON_MAX_MODELS; iterator_model++)
+		if (models[iterator_model].context != NULL && strcmp(models[iterator_model].name, name) == 0)
+			return &models[iterator_model];
+
+	return NULL;
+}
+
+/* unload_model: frees the context and the datacenter of a model
+ * parameter: model
+ * returns: nothing, it's void
+*/
+static void unload_model(struct daemon_model *model)
+{
+	vmpos_destroy(model->context);
+	free_datacenter(&model->datacenter);
+	model->context = NULL;
+}
+
+/* load_model: loads a datacenter file in a free model, with the configuration of vmpos_config.vmp
+ * parameter: models
+ * parameter: name of the model, a model with the same name is replaced once the file is loaded
+ * parameter: path to the datacenter file
+ * parameter: if the VMs run critical services
+ * returns: the model, NULL if the file could not be read or there is no free model. Then a model with the same name is kept
+*/
+static struct daemon_model *load_model(struct daemon_model *models, char *name, char *path_to_file, int CRITICAL_SERVICES)
+{
+	int iterator_model;
+	struct datacenter datacenter;
+	struct daemon_model *model = find_model(models, name);
+
+	/* a new model takes a free slot, a replaced model keeps the slot of the old one */
+	if (model == NULL)
+	{
+		for (iterator_model = 0; iterator_model < DAEMON_MAX_MODELS && models[iterator_model].context != NULL; iterator_model++);
+
+		if (iterator_model == DAEMON_MAX_MODELS)
+			return NULL;
+
+		model = &models[iterator_model];
+	}
+
+	if (!load_datacenter(path_to_file, &datacenter, CRITICAL_SERVICES))
+		return NULL;
+
+	if (model->context != NULL)
+		unload_model(model);
+
+	model->datacenter = datacenter;
+	snprintf(model->name, DAEMON_NAME_SIZE, "%s", name);
+	model->context = vmpos_create(&model->datacenter, CRITICAL_SERVICES);
+	model->context->results_directory = NULL;
+	load_dc_config(model->context, "vmpos_config.vmp");
+
+	return model;
+}
+
+/* set_parameter: changes a parameter of the configuration of a context
+ * parameter: solver context
+ * parameter: name of the parameter
+ * parameter: value
+ * returns: 1 if the parameter exists, 0 otherwise
+*/
+static int set_parameter(struct vmpos_context *context, char *parameter, char *value)
+{
+	if (strcmp(parameter, "individuals") == 0)
+		context->total_of_individuals = atoi(value);
+	else if (strcmp(parameter, "seed") == 0)
+		context->seed = strtoull(value, NULL, 10);
+	else if (strcmp(parameter, "threads") == 0)
+		context->number_of_threads = atoi(value);
+	else if (strcmp(parameter, "archive") == 0)
+		context->archive_max_size = atoi(value);
+	else if (strcmp(parameter, "mutation") == 0)
+		context->mutation_rate = atof(value);
+	else if (strcmp(parameter, "islands") == 0)
+		context->number_of_islands = atoi(value);
+	else if (strcmp(parameter, "interval") == 0)
+		context->migration_interval = atoi(value);
+	else if (strcmp(parameter, "migrants") == 0)
+		context->number_of_migrants = atoi(value);
+	else if (strcmp(parameter, "topology") == 0)
+		context->migration_topology = atoi(value);
+	else if (strcmp(parameter, "energy") == 0)
+		context->energy_objective_weight = atof(value);
+	else if (strcmp(parameter, "dispersion") == 0)
+		context->dispersion_objective_weight = atof(value);
+	else if (strcmp(parameter, "migration") == 0)
+		context->migration_objective_weight = atof(value);
+	else if (strcmp(parameter, "cl_cs") == 0)
+		context->cl_cs = atof(value);
+	else if (strcmp(parameter, "cl_nc") == 0)
+		context->cl_nc = atof(value);
+	else if (strcmp(parameter, "mc_cs") == 0)
+		context->mc_cs = atof(value);
+	else if (strcmp(parameter, "mc_ncs") == 0)
+		context->mc_ncs = atof(value);
+	else
+		return 0;
+
+	return 1;
+}
+
+/* set_base: sets the base placement of a model from the rest of a BASE request
+ * parameter: model
+ * parameter: PMs of the VMs, from 1 to h_size or 0 for a VM not allocated, separated by blanks
+ * returns: number of VMs allocated in the base placement, -1 if there are not exactly v_size PMs or a PM does not exist.
+ *          With 0 VMs allocated the base placement is not set: the solve could not build P_0 with no PM, and it would
+ *          take a random base placement instead
+*/
+static int set_base(struct daemon_model *model, char *placement)
+{
+	int iterator_virtual;
+	int v_size = model->datacenter.v_size;
+	int h_size = model->datacenter.h_size;
+	int allocated = 0;
+	long physical;
+	char *end;
+	int *base_solution;
+
+	base_solution = (int *) malloc (v_size * sizeof (int));
+
+	if (base_solution == NULL)
+	{
+		printf ("[ERROR]: Problem with memory space. Function malloc returned NULL!\n");
+		exit (EXIT_FAILURE);
+	}
+
+	for (iterator_virtual = 0; iterator_virtual < v_size; iterator_virtual++)
+	{
+		physical = strtol(placement, &end, 10);
+		if (end == placement || physical < 0 || physical > h_size)
+			break;
+		base_solution[iterator_virtual] = (int) physical;
+		if (physical > 0)
+			allocated++;
+		placement = end;
+	}
+
+	/* nothing but blanks may follow the PM of the last VM */
+	while (*placement == ' ' || *placement == '\t')
+		placement++;
+
+	if (iterator_virtual < v_size || *placement != '\0')
+		allocated = -1;
+	else if (allocated > 0)
+		allocated = vmpos_set_base_solution(model->context, base_solution);
+
+	free(base_solution);
+
+	return allocated;
+}
+
+/* write_front: writes the Pareto front of the last solve of a model
+ * parameter: model
+ * parameter: stream of the answers
+ * returns: nothing, it's void
+*/
+static void write_front(struct daemon_model *model, FILE *answers)
+{
+	int iterator_element, iterator_virtual;
+	struct pareto_archive *archive = model->context->pareto_archive;
+	struct pareto_element *element;
+
+	fprintf(answers, "OK %d\n", archive->size);
+
+	for (iterator_element = 0; iterator_element < archive->size; iterator_element++)
+	{
+		element = &archive->elements[iterator_element];
+		fprintf(answers, "%.9g %.9g %.9g", element->costs[0], element->costs[1], element->costs[2]);
+
+		for (iterator_virtual = 0; iterator_virtual < archive->v_size; iterator_virtual++)
+			fprintf(answers, " %d", element->solution[iterator_virtual]);
+
+		fprintf(answers, "\n");
+	}
+}
+
+/* handle_request: answers one request
+ * parameter: models
+ * parameter: line of the request, it is changed
+ * parameter: stream of the answers
+ * parameter: if the VMs run critical services
+ * returns: 0 if the daemon must stop, 1 otherwise
+*/
+static int handle_request(struct daemon_model *models, char *line, FILE *answers, int CRITICAL_SERVICES)
+{
+	char *state;
+	char *command = strtok_r(line, " \t\r\n", &state);
+	char *name = strtok_r(NULL, " \t\r\n", &state);
+	char *argument, *value;
+	struct daemon_model *model;
+	int allocated;
+
+	if (command == NULL)
+		return 1;
+
+	if (strcmp(command, "SHUTDOWN") == 0)
+	{
+		fprintf(answers, "OK\n");
+		return 0;
+	}
+
+	if (strcmp(command, "LOAD") == 0)
+	{
+		argument = strtok_r(NULL, "\r\n", &state);
+
+		if (name == NULL || argument == NULL)
+			fprintf(answers, "ERROR usage: LOAD name path\n");
+		else if ((model = load_model(models, name, argument, CRITICAL_SERVICES)) == NULL)
+			fprintf(answers, "ERROR could not load %s\n", argument);
+		else
+			fprintf(answers, "OK %d %d\n", model->datacenter.h_size, model->datacenter.v_size);
+
+		return 1;
+	}
+
+	/* the other requests are on a loaded model */
+	if ((model = find_model(models, name)) == NULL)
+	{
+		fprintf(answers, "ERROR unknown model\n");
+		return 1;
+	}
+
+	if (strcmp(command, "UNLOAD") == 0)
+	{
+		unload_model(model);
+		fprintf(answers, "OK\n");
+	}
+	else if (strcmp(command, "BASE") == 0)
+	{
+		argument = strtok_r(NULL, "\r\n", &state);
+
+		if (argument == NULL)
+			fprintf(answers, "OK %d\n", vmpos_set_base_solution(model->context, NULL));
+		else if ((allocated = set_base(model, argument)) < 0)
+			fprintf(answers, "ERROR the base placement needs the PM (0 to %d) of each of the %d VMs\n", model->datacenter.h_size, model->datacenter.v_size);
+		else if (allocated == 0)
+			fprintf(answers, "ERROR the base placement has no VM allocated\n");
+		else
+			fprintf(answers, "OK %d\n", allocated);
+	}
+	else if (strcmp(command, "SET") == 0)
+	{
+		argument = strtok_r(NULL, " \t\r\n", &state);
+		value = strtok_r(NULL, " \t\r\n", &state);
+
+		if (argument == NULL || value == NULL || !set_parameter(model->context, argument, value))
+			fprintf(answers, "ERROR usage: SET name parameter value\n");
+		else
+			fprintf(answers, "OK\n");
+	}
+	else if (strcmp(command, "SOLVE") == 0)
+	{
+		argument = strtok_r(NULL, " \t\r\n", &state);
+		value = strtok_r(NULL, " \t\r\n", &state);
+
+		if (argument == NULL)
+		{
+			fprintf(answers, "ERROR usage: SOLVE name generations [milliseconds]\n");
+			return 1;
+		}
+
+		model->context->total_of_generations = atoi(argument);
+		model->context->time_limit = value != NULL ? atof(value) / 1000.0 : 0.0;
+
+		if (!vmpos_solve(model->context))
+			fprintf(answers, "ERROR the configuration is not valid\n");
+		else
+			fprintf(answers, "OK %d %d\n", model->context->generation, model->context->pareto_archive->size);
+	}
+	else if (strcmp(command, "FRONT") == 0)
+	{
+		if (model->context->pareto_archive == NULL)
+			fprintf(answers, "ERROR the model was not solved\n");
+		else
+			write_front(model, answers);
+	}
+	else
+		fprintf(answers, "ERROR unknown request %s\n", command);
+
+	return 1;
+}
+
+/* run_daemon: serves the requests of the clients of a Unix domain socket until a SHUTDOWN request
+ * parameter: path of the socket, a file that exists there is replaced
+ * parameter: if the VMs run critical services
+ * returns: 1 if the daemon stopped with a SHUTDOWN request, 0 if the socket could not be opened
+*/
+int run_daemon(char socket_path[], int CRITICAL_SERVICES)
+{
+	int iterator_model;
+	int server, client, running = 1;
+	struct sockaddr_un address;
+	struct daemon_model *models;
+	FILE *requests, *answers;
+	char *line = NULL;
+	size_t line_size = 0;
+
+	if (strlen(socket_path) >= sizeof (address.sun_path))
+	{
+		printf ("[ERROR]: The path of the socket %s is too long.\n", socket_path);
+		return 0;
+	}
+
+	/* a client that leaves before its answer must not stop the daemon */
+	signal(SIGPIPE, SIG_IGN);
+
+	memset(&address, 0, sizeof (address));
+	address.sun_family = AF_UNIX;
+	strcpy(address.sun_path, socket_path);
+
+	server = socket(AF_UNIX, SOCK_STREAM, 0);
+	unlink(socket_path);
+
+	if (server < 0 || bind(server, (struct sockaddr *) &address, sizeof (address)) != 0 || listen(server, 16) != 0)
+	{
+		printf ("[ERROR]: Could not open the socket %s.\n", socket_path);
+		if (server >= 0)
+			close(server);
+		return 0;
+	}
+
+	models = (struct daemon_model *) calloc (DAEMON_MAX_MODELS, sizeof (struct daemon_model));
+
+	if (models == NULL)
+	{
+		printf ("[ERROR]: Problem with memory space. Function calloc returned NULL!\n");
+		exit (EXIT_FAILURE);
+	}
+
+	while (running)
+	{
+		if ((client = accept(server, NULL, NULL)) < 0)
+			continue;
+
+		requests = fdopen(client, "r");
+		answers = fdopen(dup(client), "w");
+
+		if (requests == NULL || answers == NULL)
+		{
+			printf ("[ERROR]: Could not open the streams of a client.\n");
+			exit (EXIT_FAILURE);
+		}
+
+		while (running && getline(&line, &line_size, requests) != -1)
+		{
+			running = handle_request(models, line, answers, CRITICAL_SERVICES);
+			fflush(answers);
+		}
+
+		fclose(requests);
+		fclose(answers);
+	}
+
+	for (iterator_model = 0; iterator_model < DAEMON_MAX_MODELS; iterator_model++)
+		if (models[iterator_model].context != NULL)
+			unload_model(&models[iterator_model]);
+
+	free(models);
+	free(line);
+	close(server);
+	unlink(socket_path);
+
+	return 1;
+}
@@ -0,0 +1,35 @@
+/*
+ * daemon.h: Virtual Machine Placement with OverSubscription Problem - Placement Daemon Header
+ * Date: 17-10-2026
+ *
+ * The daemon keeps datacenter models loaded, each one with its solver context, and answers
+ * requests over a local Unix domain socket, so a placement decision does not pay the start of
+ * a process and the reading of the files. Requests and answers are text lines:
+ *
+ *     LOAD name path                  loads a datacenter file (text or binary) and vmpos_config.vmp
+ *     BASE name pm_1 ... pm_v         sets the base placement (PMs from 1, 0 for none), BASE name alone for a random one
+ *     SET name parameter value        changes a parameter of the configuration (see daemon.c)
+ *     SOLVE name generations [ms]     solves with a generation budget and an optional time budget
+ *     FRONT name                      the Pareto front of the last solve
+ *     UNLOAD name                     frees a model
+ *     SHUTDOWN                        stops the daemon
+ *
+ * Every answer starts with OK or ERROR. BASE answers "OK allocated" with the number of VMs
+ * allocated in the base placement, and ERROR if it has no VM allocated: the placement is not
+ * changed, since a solve would replace a base placement without VMs by a random one. FRONT
+ * answers "OK size" and then one line per solution with its energy, dispersion and migration
+ * costs followed by the PM of each VM.
+*/
+
+#ifndef DAEMON_H
+#define DAEMON_H
+
+/* models loaded at the same time */
+#define DAEMON_MAX_MODELS 64
+/* length of the name of a model */
+#define DAEMON_NAME_SIZE 64
+
+/* function headers definitions */
+int run_daemon(char socket_path[], int CRITICAL_SERVICES);
+
+#endif
@@ -0,0 +1,395 @@
+/*
+ * datacenter.c: Virtual Machine Placement with OverSubscription Problem - Datacenter Loader
+ * Date: 17-10-2026
+ *
+ * The datacenter file is mapped once and scanned line by line. Every data line of the
+ * PHYSICAL MACHINES and VIRTUAL MACHINES blocks is parsed with a small integer parser
+ * into a growing block of machines, that is finally stored as 4 contiguous columns.
+ * A binary columnar file (.vmpb) is not parsed at all: its columns are used directly
+ * from the mapping, without copies.
+*/
+
+/* include libraries */
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/* include datacenter header */
+#include "datacenter.h"
+#include "common.h"
+
+/* blocks of the datacenter file */
+#define BLOCK_NONE 0
+#define BLOCK_PHYSICAL 1
+#define BLOCK_VIRTUAL 2
+
+/* number of columns of a physical or virtual machine line */
+#define DATACENTER_COLUMNS 4
+
+/* line_contains: verify if a line of the mapped file contains a text
+ * parameter: begin of the line
+ * parameter: end of the line (not included)
+ * parameter: text to search for
+ * returns: 1 if the text is in the line, otherwise returns 0
+*/
+static int line_contains(const char *line, const char *line_end, const char *text)
+{
+	size_t text_length = strlen(text);
+	const char *position;
+
+	for (position = line; position + text_length <= line_end; position++)
+	{
+		if (*position == *text && memcmp(position, text, text_length) == 0)
+			return 1;
+	}
+	return 0;
+}
+
+/* parse_line: parses the columns of a machine line
+ * parameter: begin of the line
+ * parameter: end of the line (not included)
+ * parameter: array where the DATACENTER_COLUMNS values are stored (missing values are 0)
+ * returns: nothing, it's void
+*/
+static void parse_line(const char *line, const char *line_end, int *columns)
+{
+	int iterator_column;
+	int negative;
+	int value;
+
+	for (iterator_column = 0; iterator_column < DATACENTER_COLUMNS; iterator_column++)
+	{
+		/* skip separators until the next number */
+		while (line < line_end && *line != '-' && (*line < '0' || *line > '9'))
+			line++;
+
+		negative = 0;
+		if (line < line_end && *line == '-')
+		{
+			negative = 1;
+			line++;
+		}
+
+		value = 0;
+		while (line < line_end && *line >= '0' && *line <= '9')
+		{
+			value = value * 10 + (*line - '0');
+			line++;
+		}
+
+		columns[iterator_column] = negative ? -value : value;
+	}
+}
+
+/* grow_block: reserves space for one more machine in a contiguous block
+ * parameter: pointer to the block
+ * parameter: pointer to the capacity of the block, in machines
+ * parameter: number of machines already in the block
+ * returns: pointer to the columns of the new machine
+*/
+static int *grow_block(int **block, int *capacity, int size)
+{
+	if (size == *capacity)
+	{
+		*capacity = (*capacity == 0) ? 64 : *capacity * 2;
+		*block = (int *) realloc (*block, (size_t) *capacity * DATACENTER_COLUMNS * sizeof (int));
+
+		if (*block == NULL)
+		{
+			printf ("[ERROR]: Problem with memory space. Function realloc returned NULL!\n");
+			exit (EXIT_FAILURE);
+		}
+	}
+	return *block + (size_t) size * DATACENTER_COLUMNS;
+}
+
+/* load_columns: stores the machines of a block of rows in 4 contiguous columns
+ * parameter: block of rows, with DATACENTER_COLUMNS values per machine
+ * parameter: number of machines
+ * parameter: pointer where the block of columns is returned
+ * returns: the DATACENTER_COLUMNS column pointers into the block of columns
+*/
+static int **load_columns(int *rows, int size, int **columns_data)
+{
+	int iterator;
+	int iterator_column;
+	int **columns = (int **) malloc (DATACENTER_COLUMNS * sizeof (int *));
+
+	*columns_data = (int *) malloc (((size_t) size * DATACENTER_COLUMNS + 1) * sizeof (int));
+
+	if (columns == NULL || *columns_data == NULL)
+	{
+		printf ("[ERROR]: Problem with memory space. Function malloc returned NULL!\n");
+		exit (EXIT_FAILURE);
+	}
+
+	for (iterator_column = 0; iterator_column < DATACENTER_COLUMNS; iterator_column++)
+	{
+		columns[iterator_column] = *columns_data + (size_t) iterator_column * size;
+
+		for (iterator = 0; iterator < size; iterator++)
+			columns[iterator_column][iterator] = rows[(size_t) iterator * DATACENTER_COLUMNS + iterator_column];
+	}
+
+	return columns;
+}
+
+/* column_bytes: size in the binary file of a column of int32 values, padded to VMPB_ALIGNMENT
+ * parameter: number of values of the column
+ * returns: size of the column, in bytes
+*/
+static size_t column_bytes(int size)
+{
+	size_t bytes = (size_t) size * sizeof (int32_t);
+	return (bytes + VMPB_ALIGNMENT - 1) / VMPB_ALIGNMENT * VMPB_ALIGNMENT;
+}
+
+/* load_binary_datacenter: points the columns of the datacenter into a mapped binary file
+ * parameter: mapped file
+ * parameter: size of the mapped file
+ * parameter: datacenter structure to fill
+ * parameter: value of the flag that indicates a virtual machine with critical services
+ * returns: 1 if the datacenter was loaded, otherwise returns 0
+*/
+static int load_binary_datacenter(void *mapped_file, size_t mapped_size, struct datacenter *datacenter, int CRITICAL_SERVICES)
+{
+	struct datacenter_binary_header *header = (struct datacenter_binary_header *) mapped_file;
+	char *column;
+	int iterator_column;
+	int iterator_virtual;
+
+	if (header->version != VMPB_VERSION || header->byte_order != VMPB_BYTE_ORDER ||
+		header->h_size > INT32_MAX || header->v_size > INT32_MAX)
+		return 0;
+
+	datacenter->h_size = (int) header->h_size;
+	datacenter->v_size = (int) header->v_size;
+
+	if (mapped_size < sizeof (struct datacenter_binary_header) +
+		DATACENTER_COLUMNS * (column_bytes(datacenter->h_size) + column_bytes(datacenter->v_size)))
+		return 0;
+
+	datacenter->H = (int **) malloc (DATACENTER_COLUMNS * sizeof (int *));
+	datacenter->V = (int **) malloc (DATACENTER_COLUMNS * sizeof (int *));
+
+	if (datacenter->H == NULL || datacenter->V == NULL)
+	{
+		printf ("[ERROR]: Problem with memory space. Function malloc returned NULL!\n");
+		exit (EXIT_FAILURE);
+	}
+
+	/* the columns are used from the mapping, without copies */
+	column = (char *) mapped_file + sizeof (struct datacenter_binary_header);
+	for (iterator_column = 0; iterator_column < DATACENTER_COLUMNS; iterator_column++)
+	{
+		datacenter->H[iterator_column] = (int *) column;
+		column += column_bytes(datacenter->h_size);
+	}
+	for (iterator_column = 0; iterator_column < DATACENTER_COLUMNS; iterator_column++)
+	{
+		datacenter->V[iterator_column] = (int *) column;
+		column += column_bytes(datacenter->v_size);
+	}
+
+	/* the critical VMs were counted at conversion, unless another flag value is in use */
+	if (header->critical_services == (uint32_t) CRITICAL_SERVICES)
+	{
+		datacenter->number_vms_sc = (int) header->number_vms_sc;
+	}
+	else
+	{
+		for (iterator_virtual = 0; iterator_virtual < datacenter->v_size; iterator_virtual++)
+			if (datacenter->V[3][iterator_virtual] == CRITICAL_SERVICES)
+				datacenter->number_vms_sc++;
+	}
+
+	datacenter->mapped_file = mapped_file;
+	datacenter->mapped_size = mapped_size;
+
+	return 1;
+}
+
+/* load_datacenter: loads the physical machines and virtual machines of a datacenter file in one pass
+ * parameter: path to the datacenter file, in text (.vmp) or binary columnar (.vmpb) format
+ * parameter: datacenter structure to fill
+ * parameter: value of the flag that indicates a virtual machine with critical services
+ * returns: 1 if the datacenter was loaded, otherwise returns 0
+*/
+int load_datacenter(char path_to_file[], struct datacenter *datacenter, int CRITICAL_SERVICES)
+{
+	/* datacenter file to read from */
+	int datacenter_file;
+	struct stat file_status;
+	/* mapped file and the line being parsed */
+	const char *mapped_file;
+	const char *line;
+	const char *line_end;
+	const char *file_end;
+	const char *first_character;
+	/* block of the file being read */
+	int reading_block = BLOCK_NONE;
+	/* capacity of the contiguous blocks, in machines */
+	int h_capacity = 0;
+	int v_capacity = 0;
+	int *columns;
+	/* machines parsed from a text file, DATACENTER_COLUMNS values per machine */
+	int *H_rows = NULL;
+	int *V_rows = NULL;
+
+	memset(datacenter, 0, sizeof (struct datacenter));
+
+ 	/* open and map the file for reading */
+	datacenter_file = open(path_to_file, O_RDONLY);
+	if (datacenter_file < 0)
+		return 0;
+
+	if (fstat(datacenter_file, &file_status) != 0 || file_status.st_size == 0)
+	{
+		close(datacenter_file);
+		return 0;
+	}
+
+	mapped_file = (const char *) mmap(NULL, file_status.st_size, PROT_READ, MAP_PRIVATE, datacenter_file, 0);
+	close(datacenter_file);
+
+	if (mapped_file == MAP_FAILED)
+		return 0;
+
+	/* a binary columnar file is used as it is */
+	if ((size_t) file_status.st_size >= sizeof (struct datacenter_binary_header) && memcmp(mapped_file, VMPB_MAGIC, 4) == 0)
+	{
+		if (!load_binary_datacenter((void *) mapped_file, file_status.st_size, datacenter, CRITICAL_SERVICES))
+		{
+			munmap((void *) mapped_file, file_status.st_size);
+			free_datacenter(datacenter);
+			return 0;
+		}
+		return 1;
+	}
+
+	/* the whole file is read sequentially once */
+	madvise((void *) mapped_file, file_status.st_size, MADV_SEQUENTIAL);
+
+	file_end = mapped_file + file_status.st_size;
+
+	for (line = mapped_file; line < file_end; line = line_end + 1)
+	{
+		line_end = memchr(line, '\n', file_end - line);
+		if (line_end == NULL)
+			line_end = file_end;
+
+		/* skip the blanks at the begin of the line */
+		for (first_character = line; first_character < line_end && (*first_character == ' ' || *first_character == '\t' || *first_character == '\r'); first_character++);
+
+		/* blank line */
+		if (first_character == line_end)
+			continue;
+
+		/* a data line of the actual block */
+		if (*first_character == '-' || (*first_character >= '0' && *first_character <= '9'))
+		{
+			if (reading_block == BLOCK_PHYSICAL)
+			{
+				/* reserve 4 columns for Processor, Memory, Storage and Power Consumption */
+				columns = grow_block(&H_rows, &h_capacity, datacenter->h_size);
+				parse_line(first_character, line_end, columns);
+				datacenter->h_size++;
+			}
+			if (reading_block == BLOCK_VIRTUAL)
+			{
+				/* reserve 4 columns for Processor, Memory, Storage and Flag for Critical Service */
+				columns = grow_block(&V_rows, &v_capacity, datacenter->v_size);
+				parse_line(first_character, line_end, columns);
+
+				//Petronio: Nivel de Dispersao
+				if (columns[3] == CRITICAL_SERVICES)
+					datacenter->number_vms_sc++;
+
+				datacenter->v_size++;
+			}
+			continue;
+		}
+
+		/* if the line is equal to H_HEADER or V_HEADER, we begin the corresponding block in the file */
+		if (line_contains(first_character, line_end, H_HEADER))
+			reading_block = BLOCK_PHYSICAL;
+		else if (line_contains(first_character, line_end, V_HEADER))
+			reading_block = BLOCK_VIRTUAL;
+	}
+
+	munmap((void *) mapped_file, file_status.st_size);
+
+	datacenter->H = load_columns(H_rows, datacenter->h_size, &datacenter->H_data);
+	datacenter->V = load_columns(V_rows, datacenter->v_size, &datacenter->V_data);
+
+	free(H_rows);
+	free(V_rows);
+
+	return 1;
+}
+
+/* save_datacenter_binary: writes a datacenter in the binary columnar format
+ * parameter: path to the binary datacenter file
+ * parameter: datacenter structure
+ * parameter: value of the flag that indicates a virtual machine with critical services
+ * returns: 1 if the file was written, otherwise returns 0
+*/
+int save_datacenter_binary(char path_to_file[], struct datacenter *datacenter, int CRITICAL_SERVICES)
+{
+	/* binary datacenter file to write to */
+	FILE *binary_file;
+	struct datacenter_binary_header header;
+	static const char padding[VMPB_ALIGNMENT] = {0};
+	int iterator_column;
+	int ok = 1;
+
+	memset(&header, 0, sizeof (struct datacenter_binary_header));
+	memcpy(header.magic, VMPB_MAGIC, 4);
+	header.version = VMPB_VERSION;
+	header.byte_order = VMPB_BYTE_ORDER;
+	header.h_size = (uint32_t) datacenter->h_size;
+	header.v_size = (uint32_t) datacenter->v_size;
+	header.number_vms_sc = (uint32_t) datacenter->number_vms_sc;
+	header.critical_services = (uint32_t) CRITICAL_SERVICES;
+
+	binary_file = fopen(path_to_file, "wb");
+	if (binary_file == NULL)
+		return 0;
+
+	ok = ok && fwrite(&header, sizeof (struct datacenter_binary_header), 1, binary_file) == 1;
+
+	/* every column is written and padded to the alignment */
+	for (iterator_column = 0; iterator_column < DATACENTER_COLUMNS; iterator_column++)
+	{
+		ok = ok && fwrite(datacenter->H[iterator_column], sizeof (int32_t), datacenter->h_size, binary_file) == (size_t) datacenter->h_size;
+		ok = ok && fwrite(padding, 1, column_bytes(datacenter->h_size) - datacenter->h_size * sizeof (int32_t), binary_file) ==
+			column_bytes(datacenter->h_size) - datacenter->h_size * sizeof (int32_t);
+	}
+	for (iterator_column = 0; iterator_column < DATACENTER_COLUMNS; iterator_column++)
+	{
+		ok = ok && fwrite(datacenter->V[iterator_column], sizeof (int32_t), datacenter->v_size, binary_file) == (size_t) datacenter->v_size;
+		ok = ok && fwrite(padding, 1, column_bytes(datacenter->v_size) - datacenter->v_size * sizeof (int32_t), binary_file) ==
+			column_bytes(datacenter->v_size) - datacenter->v_size * sizeof (int32_t);
+	}
+
+	if (fclose(binary_file) != 0)
+		ok = 0;
+
+	return ok;
+}
+
+/* free_datacenter: frees the memory of a loaded datacenter
+ * parameter: datacenter structure
+ * returns: nothing, it's void
+*/
+void free_datacenter(struct datacenter *datacenter)
+{
+	free(datacenter->H);
+	free(datacenter->V);
+	free(datacenter->H_data);
+	free(datacenter->V_data);
+	if (datacenter->mapped_file != NULL)
+		munmap(datacenter->mapped_file, datacenter->mapped_size);
+	memset(datacenter, 0, sizeof (struct datacenter));
+}
@@ -0,0 +1,66 @@
+/*
+ * datacenter.h: Virtual Machine Placement with OverSubscription Problem - Datacenter Loader Header
+ * Date: 17-10-2026
+ *
+ * Single pass loader of the datacenter file: the file is mapped in memory once and the
+ * PHYSICAL MACHINES and VIRTUAL MACHINES blocks are parsed directly into contiguous arrays.
+ * Datacenters in the binary columnar format (.vmpb) are used straight from the mapping.
+*/
+
+#ifndef DATACENTER_H
+#define DATACENTER_H
+
+/* include libraries */
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+/* definitions of the binary columnar format */
+#define VMPB_MAGIC "VMPB"
+#define VMPB_VERSION 1
+#define VMPB_BYTE_ORDER 0x01020304
+/* every column begins in a multiple of VMPB_ALIGNMENT bytes */
+#define VMPB_ALIGNMENT 64
+
+/* header of a binary datacenter file (64 bytes), followed by the columns of H
+ * (processor, memory, storage, power) and the columns of V (processor, memory,
+ * storage, critical flag), every one of them a padded array of int32 values */
+struct datacenter_binary_header
+{
+	char magic[4];
+	uint32_t version;
+	uint32_t byte_order;
+	uint32_t h_size;
+	uint32_t v_size;
+	/* number of virtual machines with the critical_services flag */
+	uint32_t number_vms_sc;
+	uint32_t critical_services;
+	uint32_t reserved[9];
+};
+
+/* structure of a loaded datacenter */
+struct datacenter
+{
+	/* number of physical and virtual machines */
+	int h_size;
+	int v_size;
+	/* number of virtual machines with critical services */
+	int number_vms_sc;
+	/* columns of H and V: H[resource][physical] and V[requirement][virtual] */
+	int **H;
+	int **V;
+	/* contiguous blocks with the columns, when loaded from a text file */
+	int *H_data;
+	int *V_data;
+	/* mapping of a binary file, the columns point into it */
+	void *mapped_file;
+	size_t mapped_size;
+};
+
+/* function headers definitions */
+int load_datacenter(char path_to_file[], struct datacenter *datacenter, int CRITICAL_SERVICES);
+int save_datacenter_binary(char path_to_file[], struct datacenter *datacenter, int CRITICAL_SERVICES);
+void free_datacenter(struct datacenter *datacenter);
+
+#endif
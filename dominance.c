@@ -0,0 +1,68 @@
+/*
+ * dominance.c: Virtual Machine Placement with OverSubscription Problem - Dominance Kernel
+ * Date: 17-10-2026
+ *
+ * Batch form of the dominance kernel. The block of solutions is given by columns, one array
+ * per objective function, so 4 solutions are loaded and compared with the candidate in each
+ * SSE instruction. Without SSE, or for the last solutions of the block, the scalar kernel is used.
+*/
+
+/* include dominance header */
+#include "dominance.h"
+
+/* dominance_batch: dominance between a candidate and a block of solutions
+ * parameter: objective functions of the candidate
+ * parameter: first objective function of the solutions of the block
+ * parameter: second objective function of the solutions of the block
+ * parameter: third objective function of the solutions of the block
+ * parameter: number of solutions of the block
+ * parameter: array for the result of each solution: 1 if the candidate dominates it, -1 if it dominates the candidate, 0 otherwise
+ * returns: nothing, it's void
+*/
+void dominance_batch(const float *candidate, const float *objective_0, const float *objective_1, const float *objective_2, int number_of_solutions, signed char *result)
+{
+	int iterator_solution = 0;
+	float solution[3];
+
+#ifdef __SSE__
+	__m128 candidate_0 = _mm_set1_ps(candidate[0]);
+	__m128 candidate_1 = _mm_set1_ps(candidate[1]);
+	__m128 candidate_2 = _mm_set1_ps(candidate[2]);
+	__m128 block_0, block_1, block_2;
+	__m128 candidate_dominates, solution_dominates;
+	int candidate_mask, solution_mask;
+
+	for (; iterator_solution + 4 <= number_of_solutions; iterator_solution += 4)
+	{
+		block_0 = _mm_loadu_ps(objective_0 + iterator_solution);
+		block_1 = _mm_loadu_ps(objective_1 + iterator_solution);
+		block_2 = _mm_loadu_ps(objective_2 + iterator_solution);
+
+		/* candidate lower or equal in all the objective functions and lower in one */
+		candidate_dominates = _mm_and_ps(
+			_mm_and_ps(_mm_and_ps(_mm_cmple_ps(candidate_0, block_0), _mm_cmple_ps(candidate_1, block_1)), _mm_cmple_ps(candidate_2, block_2)),
+			_mm_or_ps(_mm_or_ps(_mm_cmplt_ps(candidate_0, block_0), _mm_cmplt_ps(candidate_1, block_1)), _mm_cmplt_ps(candidate_2, block_2)));
+
+		/* solution lower or equal in all the objective functions and lower in one */
+		solution_dominates = _mm_and_ps(
+			_mm_and_ps(_mm_and_ps(_mm_cmple_ps(block_0, candidate_0), _mm_cmple_ps(block_1, candidate_1)), _mm_cmple_ps(block_2, candidate_2)),
+			_mm_or_ps(_mm_or_ps(_mm_cmplt_ps(block_0, candidate_0), _mm_cmplt_ps(block_1, candidate_1)), _mm_cmplt_ps(block_2, candidate_2)));
+
+		candidate_mask = _mm_movemask_ps(candidate_dominates);
+		solution_mask = _mm_movemask_ps(solution_dominates);
+
+		result[iterator_solution] = (candidate_mask & 1) - (solution_mask & 1);
+		result[iterator_solution + 1] = ((candidate_mask >> 1) & 1) - ((solution_mask >> 1) & 1);
+		result[iterator_solution + 2] = ((candidate_mask >> 2) & 1) - ((solution_mask >> 2) & 1);
+		result[iterator_solution + 3] = ((candidate_mask >> 3) & 1) - ((solution_mask >> 3) & 1);
+	}
+#endif
+
+	for (; iterator_solution < number_of_solutions; iterator_solution++)
+	{
+		solution[0] = objective_0[iterator_solution];
+		solution[1] = objective_1[iterator_solution];
+		solution[2] = objective_2[iterator_solution];
+		result[iterator_solution] = (signed char) dominance(candidate, solution);
+	}
+}
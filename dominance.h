@@ -0,0 +1,49 @@
+/*
+ * dominance.h: Virtual Machine Placement with OverSubscription Problem - Dominance Kernel Header
+ * Date: 17-10-2026
+ *
+ * A solution a dominates a solution b if a is lower or equal in all the objective functions
+ * and lower in at least one. The kernel compares the 3 objective functions at once with SSE
+ * compares and masks, without branches. The batch form compares a candidate with a block of
+ * solutions stored by columns, 4 solutions per instruction.
+*/
+
+#ifndef DOMINANCE_H
+#define DOMINANCE_H
+
+#ifdef __SSE__
+#include <xmmintrin.h>
+#endif
+
+/* dominance: dominance between two vectors of 3 objective functions
+ * parameter: objective functions of the solution a
+ * parameter: objective functions of the solution b
+ * returns: 1 if a dominates b, -1 if b dominates a, 0 if both a and b are non-dominated
+*/
+static inline int dominance(const float *a, const float *b)
+{
+#ifdef __SSE__
+	/* the fourth lane is 0 in both, lower or equal and not lower, so it does not change the masks */
+	__m128 vector_a = _mm_setr_ps(a[0], a[1], a[2], 0.0f);
+	__m128 vector_b = _mm_setr_ps(b[0], b[1], b[2], 0.0f);
+
+	int a_lower_equal = _mm_movemask_ps(_mm_cmple_ps(vector_a, vector_b));
+	int a_lower = _mm_movemask_ps(_mm_cmplt_ps(vector_a, vector_b));
+	int b_lower_equal = _mm_movemask_ps(_mm_cmple_ps(vector_b, vector_a));
+	int b_lower = _mm_movemask_ps(_mm_cmplt_ps(vector_b, vector_a));
+
+	return ((a_lower_equal == 15) & (a_lower != 0)) - ((b_lower_equal == 15) & (b_lower != 0));
+#else
+	int a_lower_equal = (a[0] <= b[0]) & (a[1] <= b[1]) & (a[2] <= b[2]);
+	int a_lower = (a[0] < b[0]) | (a[1] < b[1]) | (a[2] < b[2]);
+	int b_lower_equal = (b[0] <= a[0]) & (b[1] <= a[1]) & (b[2] <= a[2]);
+	int b_lower = (b[0] < a[0]) | (b[1] < a[1]) | (b[2] < a[2]);
+
+	return (a_lower_equal & a_lower) - (b_lower_equal & b_lower);
+#endif
+}
+
+/* function headers definitions */
+void dominance_batch(const float *candidate, const float *objective_0, const float *objective_1, const float *objective_2, int number_of_solutions, signed char *result);
+
+#endif
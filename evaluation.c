@@ -0,0 +1,328 @@
+/*
+ * evaluation.c: Virtual Machine Placement with OverSubscription Problem - Incremental Evaluation
+ * Date: 17-10-2026
+ *
+ * A move of a virtual machine only changes the source and destination physical machines, so
+ * their contributions to the energy consumption and to the dispersion level are subtracted,
+ * recalculated and added back, and the migration cost counters are adjusted with the base
+ * solution position of the virtual machine. load_objectives then reads the sums. The virtual
+ * machines of each physical machine are kept in a list, so the repair and the local search
+ * visit them in O(VMs on the PM) instead of scanning the whole individual.
+*/
+
+/* include evaluation header */
+#include "evaluation.h"
+#include "commitment.h"
+#include "common.h"
+
+/* evaluate_physical: calculates the contribution of a physical machine to the objective functions, as load_objectives
+ * parameter: solver context
+ * parameter: population, with its utilization loaded
+ * parameter: commitment matrix
+ * parameter: physical machines matrix
+ * parameter: individual
+ * parameter: physical machine
+ * returns: nothing, it's void
+*/
+static void evaluate_physical(struct vmpos_context *context, struct population *population, float **cm, int **H, int individual, int physical)
+{
+	struct physical_evaluation *evaluation = PHYSICAL_EVALUATION(population, individual, physical);
+	int *utilization = UTILIZATION(population, individual, physical);
+	/* utility of a physical machine */
+	float utilidad;
+
+	evaluation->power = 0.0;
+	evaluation->counted_cs = evaluation->counted_ncs = 0;
+
+	if (utilization[0] > 0)
+	{
+		/* calculates utility and energy consumption of the physical machine */
+		utilidad = (float) utilization[0] / ( (float) H[0][physical] * cm[individual][physical] );
+
+		evaluation->power = ( (float) H[3][physical] - ( (float) H[3][physical] * 0.6) ) * utilidad +
+		( (float) H[3][physical] * 0.6 );
+
+		if (context->cl_cs == context->cl_nc)
+		{
+			evaluation->counted_cs = evaluation->critical_vms > 0;
+			evaluation->counted_ncs = evaluation->no_critical_vms > 0;
+		}
+		else
+		{
+			if (cm[individual][physical] == context->cl_cs)
+			{
+				evaluation->counted_cs = 1;
+				evaluation->counted_ncs = evaluation->no_critical_vms > 0;
+			}
+			else
+				evaluation->counted_ncs = 1;
+		}
+	}
+}
+
+/* add_physical: adds (sign 1) or subtracts (sign -1) the contribution of a physical machine to the sums of its individual
+ * parameter: population
+ * parameter: individual
+ * parameter: physical machine
+ * parameter: sign of the operation
+ * returns: nothing, it's void
+*/
+static void add_physical(struct population *population, int individual, int physical, int sign)
+{
+	struct physical_evaluation *physical_evaluation = PHYSICAL_EVALUATION(population, individual, physical);
+	struct individual_evaluation *evaluation = population->evaluation + individual;
+
+	evaluation->energy += sign * physical_evaluation->power;
+	evaluation->pm_cs += sign * physical_evaluation->counted_cs;
+	evaluation->pm_ncs += sign * physical_evaluation->counted_ncs;
+}
+
+/* unlink_virtual_machine: removes a virtual machine from the list of its position
+ * parameter: population
+ * parameter: individual
+ * parameter: virtual machine
+ * parameter: position of the virtual machine (gene value)
+ * returns: nothing, it's void
+*/
+static void unlink_virtual_machine(struct population *population, int individual, int virtual_machine, int position)
+{
+	int previous = PREVIOUS_VIRTUAL_MACHINE(population, individual, virtual_machine);
+	int next = NEXT_VIRTUAL_MACHINE(population, individual, virtual_machine);
+
+	if (previous != -1)
+		NEXT_VIRTUAL_MACHINE(population, individual, previous) = next;
+	else
+		FIRST_VIRTUAL_MACHINE(population, individual, position) = next;
+
+	if (next != -1)
+		PREVIOUS_VIRTUAL_MACHINE(population, individual, next) = previous;
+}
+
+/* link_virtual_machine: inserts a virtual machine in the list of a position, keeping the increasing order
+ * parameter: population
+ * parameter: individual
+ * parameter: virtual machine
+ * parameter: position of the virtual machine (gene value)
+ * returns: nothing, it's void
+*/
+static void link_virtual_machine(struct population *population, int individual, int virtual_machine, int position)
+{
+	int previous = -1;
+	int next = FIRST_VIRTUAL_MACHINE(population, individual, position);
+
+	while (next != -1 && next < virtual_machine)
+	{
+		previous = next;
+		next = NEXT_VIRTUAL_MACHINE(population, individual, next);
+	}
+
+	PREVIOUS_VIRTUAL_MACHINE(population, individual, virtual_machine) = previous;
+	NEXT_VIRTUAL_MACHINE(population, individual, virtual_machine) = next;
+
+	if (previous != -1)
+		NEXT_VIRTUAL_MACHINE(population, individual, previous) = virtual_machine;
+	else
+		FIRST_VIRTUAL_MACHINE(population, individual, position) = virtual_machine;
+
+	if (next != -1)
+		PREVIOUS_VIRTUAL_MACHINE(population, individual, next) = virtual_machine;
+}
+
+/* load_evaluation: calculates from scratch the partial sums of the objective functions of each individual
+ * parameter: solver context
+ * parameter: population, with its utilization loaded
+ * parameter: commitment matrix
+ * parameter: physical machines matrix
+ * parameter: virtual machines matrix
+ * parameter: number of individuals
+ * parameter: number of physical machines
+ * parameter: number of virtual machines
+ * returns: nothing, it's void
+*/
+void load_evaluation(struct vmpos_context *context, struct population *population, float **cm, int **H, int **V, int number_of_individuals, int h_size, int v_size, int CRITICAL_SERVICES)
+{
+	/* iterators */
+	int iterator_individual;
+	int iterator_virtual;
+	int iterator_physical;
+	int *individual;
+
+	struct individual_evaluation *evaluation;
+
+	/* the sums are kept for every individual of the population, with the h_size of its utilization */
+	if (population->physical_evaluation == NULL)
+	{
+		population->physical_evaluation = (struct physical_evaluation *) arena_alloc (population->arena, (size_t) population->number_of_individuals * population->h_size * sizeof (struct physical_evaluation));
+		population->evaluation = (struct individual_evaluation *) arena_alloc (population->arena, (size_t) population->number_of_individuals * sizeof (struct individual_evaluation));
+		population->first_virtual_machine = (int *) arena_alloc (population->arena, (size_t) population->number_of_individuals * (population->h_size + 1) * sizeof (int));
+		population->next_virtual_machine = (int *) arena_alloc (population->arena, (size_t) population->number_of_individuals * v_size * sizeof (int));
+		population->previous_virtual_machine = (int *) arena_alloc (population->arena, (size_t) population->number_of_individuals * v_size * sizeof (int));
+	}
+
+	memset(population->physical_evaluation, 0, (size_t) number_of_individuals * h_size * sizeof (struct physical_evaluation));
+	memset(population->evaluation, 0, (size_t) number_of_individuals * sizeof (struct individual_evaluation));
+	/* all bytes to 0xff is -1, the empty lists */
+	memset(population->first_virtual_machine, 0xff, (size_t) number_of_individuals * (h_size + 1) * sizeof (int));
+
+	/* iterate on individuals */
+	for (iterator_individual = 0; iterator_individual < number_of_individuals; iterator_individual++)
+	{
+		individual = INDIVIDUAL(population, iterator_individual);
+		evaluation = population->evaluation + iterator_individual;
+
+		/* count the virtual machines of each physical machine and the virtual machines out of their base position.
+		   The virtual machines are taken backwards and pushed at the front of their lists, that stay in increasing order */
+		for (iterator_virtual = v_size - 1; iterator_virtual >= 0; iterator_virtual--)
+		{
+			NEXT_VIRTUAL_MACHINE(population, iterator_individual, iterator_virtual) = FIRST_VIRTUAL_MACHINE(population, iterator_individual, individual[iterator_virtual]);
+			PREVIOUS_VIRTUAL_MACHINE(population, iterator_individual, iterator_virtual) = -1;
+			if (NEXT_VIRTUAL_MACHINE(population, iterator_individual, iterator_virtual) != -1)
+				PREVIOUS_VIRTUAL_MACHINE(population, iterator_individual, NEXT_VIRTUAL_MACHINE(population, iterator_individual, iterator_virtual)) = iterator_virtual;
+			FIRST_VIRTUAL_MACHINE(population, iterator_individual, individual[iterator_virtual]) = iterator_virtual;
+
+			if (individual[iterator_virtual] != 0)
+			{
+				if (V[3][iterator_virtual] == CRITICAL_SERVICES)
+					PHYSICAL_EVALUATION(population, iterator_individual, individual[iterator_virtual]-1)->critical_vms++;
+				else
+					PHYSICAL_EVALUATION(population, iterator_individual, individual[iterator_virtual]-1)->no_critical_vms++;
+			}
+
+			if (context->base_solution[iterator_virtual] != individual[iterator_virtual])
+			{
+				if (V[3][iterator_virtual] == CRITICAL_SERVICES)
+					evaluation->moved_cs++;
+				else
+					evaluation->moved_ncs++;
+			}
+		}
+
+		/* iterate on physical machines */
+		for (iterator_physical = 0; iterator_physical < h_size; iterator_physical++)
+		{
+			evaluate_physical(context, population, cm, H, iterator_individual, iterator_physical);
+			add_physical(population, iterator_individual, iterator_physical, 1);
+		}
+	}
+}
+
+/* move_virtual_machine: changes the placement of a virtual machine, updating utilization, commitment matrix and evaluation
+ * parameter: solver context
+ * parameter: population, with its utilization and evaluation loaded
+ * parameter: commitment matrix
+ * parameter: physical machines matrix
+ * parameter: virtual machines matrix
+ * parameter: individual
+ * parameter: virtual machine to move
+ * parameter: new position of the virtual machine, a physical machine number or 0 to leave it not placed
+ * returns: nothing, it's void
+*/
+void move_virtual_machine(struct vmpos_context *context, struct population *population, float **cm, int **H, int **V, int individual, int virtual_machine, int physical, int CRITICAL_SERVICES)
+{
+	int *genes = INDIVIDUAL(population, individual);
+	int source = genes[virtual_machine];
+	int critical = (V[3][virtual_machine] == CRITICAL_SERVICES);
+	int *utilization;
+	struct individual_evaluation *evaluation = population->evaluation + individual;
+
+	if (source == physical)
+		return;
+
+	PROFILE_COUNT(PROFILE_VM_MOVES);
+
+	/* the contributions of the source and destination physical machines are recalculated */
+	if (source != 0)
+		add_physical(population, individual, source-1, -1);
+	if (physical != 0)
+		add_physical(population, individual, physical-1, -1);
+
+	/* delete requirements from the source physical machine */
+	if (source != 0)
+	{
+		utilization = UTILIZATION(population, individual, source-1);
+		utilization[0] -= V[0][virtual_machine];
+		utilization[1] -= V[1][virtual_machine];
+		utilization[2] -= V[2][virtual_machine];
+
+		if (critical)
+			PHYSICAL_EVALUATION(population, individual, source-1)->critical_vms--;
+		else
+			PHYSICAL_EVALUATION(population, individual, source-1)->no_critical_vms--;
+	}
+
+	/* add requirements to the destination physical machine */
+	if (physical != 0)
+	{
+		utilization = UTILIZATION(population, individual, physical-1);
+		utilization[0] += V[0][virtual_machine];
+		utilization[1] += V[1][virtual_machine];
+		utilization[2] += V[2][virtual_machine];
+
+		if (critical)
+			PHYSICAL_EVALUATION(population, individual, physical-1)->critical_vms++;
+		else
+			PHYSICAL_EVALUATION(population, individual, physical-1)->no_critical_vms++;
+	}
+
+	/* migration cost: the virtual machine can leave or come back to its base solution position */
+	if (critical)
+		evaluation->moved_cs += (context->base_solution[virtual_machine] != physical) - (context->base_solution[virtual_machine] != source);
+	else
+		evaluation->moved_ncs += (context->base_solution[virtual_machine] != physical) - (context->base_solution[virtual_machine] != source);
+
+	/* refresh the population and the lists of virtual machines */
+	unlink_virtual_machine(population, individual, virtual_machine, source);
+	link_virtual_machine(population, individual, virtual_machine, physical);
+	genes[virtual_machine] = physical;
+
+	/* updte the commitment matrix, only the source and destination physical machines can change */
+	if (source != 0)
+		cm[individual][source-1] = commitment_level(context, population, individual, source-1);
+	if (physical != 0)
+		cm[individual][physical-1] = commitment_level(context, population, individual, physical-1);
+
+	if (source != 0)
+	{
+		evaluate_physical(context, population, cm, H, individual, source-1);
+		add_physical(population, individual, source-1, 1);
+	}
+	if (physical != 0)
+	{
+		evaluate_physical(context, population, cm, H, individual, physical-1);
+		add_physical(population, individual, physical-1, 1);
+	}
+}
+
+/* evaluation_objectives: calculates the cost of each objective of an individual from its partial sums
+ * parameter: solver context
+ * parameter: population, with its evaluation loaded
+ * parameter: individual
+ * parameter: number of virtual machines
+ * parameter: array for the cost of the 3 objectives
+ * returns: nothing, it's void
+*/
+void evaluation_objectives(struct vmpos_context *context, struct population *population, int individual, int v_size, float *objectives)
+{
+	struct individual_evaluation *evaluation = population->evaluation + individual;
+	int total_pm_CS = evaluation->pm_cs;
+	int total_pm_NCS = evaluation->pm_ncs;
+
+	/* (OF1) energy consumption */
+	objectives[0] = (float) evaluation->energy;
+
+	/* (OF2) Dispersion Level */
+	if(total_pm_CS != 0 && total_pm_NCS != 0)
+	{
+		objectives[1] = ( (float)total_pm_CS / ( ((float)context->number_vms_sc/(float)total_pm_CS) + ( ((float)v_size - (float)context->number_vms_sc) / total_pm_NCS ) ) );
+	}
+	else
+	{
+		if(total_pm_CS == 0)
+			objectives[1] = ((float)(v_size - (float)context->number_vms_sc) / (float)total_pm_NCS);
+		else
+			objectives[1] = ((float) context->number_vms_sc / (float)total_pm_CS);
+	}
+
+	/* (OF3) migration cost */
+	objectives[2] = (float)(evaluation->moved_cs * context->mc_cs) + (float)(evaluation->moved_ncs * context->mc_ncs);
+}
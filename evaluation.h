@@ -0,0 +1,23 @@
+/*
+ * evaluation.h: Virtual Machine Placement with OverSubscription Problem - Incremental Evaluation Header
+ * Date: 17-10-2026
+ *
+ * The objective functions of an individual are kept as partial sums: the power of each
+ * physical machine, the physical machines with and without critical services and the
+ * virtual machines out of their base solution position. A virtual machine moved with
+ * move_virtual_machine updates them in O(1), so the repair, local search and mutation do
+ * not need a full evaluation of the individual afterwards.
+*/
+
+#ifndef EVALUATION_H
+#define EVALUATION_H
+
+#include "population.h"
+#include "context.h"
+
+/* function headers definitions */
+void load_evaluation(struct vmpos_context *context, struct population *population, float **cm, int **H, int **V, int number_of_individuals, int h_size, int v_size, int CRITICAL_SERVICES);
+void move_virtual_machine(struct vmpos_context *context, struct population *population, float **cm, int **H, int **V, int individual, int virtual_machine, int physical, int CRITICAL_SERVICES);
+void evaluation_objectives(struct vmpos_context *context, struct population *population, int individual, int v_size, float *objectives);
+
+#endif
@@ -0,0 +1,122 @@
+/*
+ * generator.c: Virtual Machine Placement with OverSubscription Problem - Datacenter Generator
+ * Date: 17-10-2026
+ *
+ * The same parameters and seed always write the same file, so the instances of a benchmark
+ * can be written again instead of kept.
+*/
+
+/* include libraries */
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+/* include datacenter generator header */
+#include "generator.h"
+#include "rng.h"
+
+/* types of PMs: processors, memory, storage and maximum power consumption */
+#define PM_TYPES 5
+static const int pm_types[PM_TYPES][4] = {
+	{4, 8, 100, 410},
+	{8, 16, 120, 410},
+	{16, 32, 140, 420},
+	{24, 48, 160, 430},
+	{32, 64, 200, 440}
+};
+
+/* generator_defaults: parameters like the ones of input/new120x600_50pc.vmp
+ * parameter: parameters to fill
+ * parameter: number of physical machines
+ * parameter: number of virtual machines
+ * returns: nothing, it's void
+*/
+void generator_defaults(struct generator_parameters *parameters, int h_size, int v_size)
+{
+	parameters->h_size = h_size;
+	parameters->v_size = v_size;
+	parameters->critical_ratio = 0.5;
+	parameters->load_factor = 0.7;
+	parameters->distribution = UNIFORM_DISTRIBUTION;
+	parameters->seed = 1;
+}
+
+/* virtual_processors: draws the number of processors of a VM
+ * parameter: random number stream
+ * parameter: distribution of the processors
+ * parameter: mean of the processors
+ * parameter: maximum number of processors, of the biggest PM
+ * returns: number of processors, at least 1
+*/
+static int virtual_processors(struct rng *rng, int distribution, double mean, int maximum)
+{
+	double processors;
+
+	if (mean <= 1.0)
+		return 1;
+
+	if (distribution == SKEWED_DISTRIBUTION)
+		/* geometric from 1, with mean 1/p */
+		processors = 1.0 + floor(log(1.0 - rng_uniform(rng)) / log(1.0 - 1.0 / mean));
+	else
+		/* uniform from 0.5 to 2 * mean - 0.5, rounded */
+		processors = floor(1.0 + rng_uniform(rng) * (2.0 * mean - 1.0));
+
+	if (processors > maximum)
+		processors = maximum;
+
+	return processors < 1.0 ? 1 : (int) processors;
+}
+
+/* generate_datacenter: writes a synthetic datacenter file
+ * parameter: path of the file to write
+ * parameter: parameters of the datacenter
+ * returns: 1 if the file was written, 0 if not
+*/
+int generate_datacenter(char path_to_file[], struct generator_parameters *parameters)
+{
+	/* iterators */
+	int iterator_physical, iterator_virtual;
+
+	struct rng rng;
+	int type, processors, critical;
+	long long total_processors = 0;
+	double mean;
+	FILE *datacenter_file;
+
+	if (parameters->h_size < 1 || parameters->v_size < 1)
+		return 0;
+
+	datacenter_file = fopen(path_to_file, "w");
+
+	if (datacenter_file == NULL)
+		return 0;
+
+	rng_seed(&rng, (uint64_t) parameters->seed);
+
+	fprintf(datacenter_file, "PHYSICAL MACHINES\n\n");
+
+	for (iterator_physical = 0; iterator_physical < parameters->h_size; iterator_physical++)
+	{
+		type = rng_bounded(&rng, PM_TYPES);
+		total_processors += pm_types[type][0];
+		fprintf(datacenter_file, "%d\t%d\t%d\t%d\t\n", pm_types[type][0], pm_types[type][1], pm_types[type][2], pm_types[type][3]);
+	}
+
+	fprintf(datacenter_file, "\nVIRTUAL MACHINES\n\n");
+
+	/* the mean of the processors of a VM that gives the load factor */
+	mean = parameters->load_factor * (double) total_processors / parameters->v_size;
+
+	for (iterator_virtual = 0; iterator_virtual < parameters->v_size; iterator_virtual++)
+	{
+		processors = virtual_processors(&rng, parameters->distribution, mean, pm_types[PM_TYPES - 1][0]);
+		critical = rng_uniform(&rng) < parameters->critical_ratio;
+		fprintf(datacenter_file, "%d\t%d\t%d\t%d\n", processors, 2 * processors, 2 * processors + 2, critical);
+	}
+
+	if (fclose(datacenter_file) != 0)
+		return 0;
+
+	return 1;
+}
@@ -0,0 +1,37 @@
+/*
+ * generator.h: Virtual Machine Placement with OverSubscription Problem - Datacenter Generator Header
+ * Date: 17-10-2026
+ *
+ * Writes synthetic datacenter files (.vmp) with a given number of PMs and VMs. The PMs are
+ * drawn from the types of the PMs of input/new120x600_50pc.vmp, from 4 to 32 processors. The
+ * processors of the VMs are drawn from a uniform or a skewed (geometric, many small VMs and
+ * few big ones) distribution, with the mean that gives the load factor: the processors of all
+ * the VMs over the processors of all the PMs. The memory and the storage of a VM follow its
+ * processors, like in the example files, and a part of the VMs run critical services.
+*/
+
+#ifndef GENERATOR_H
+#define GENERATOR_H
+
+/* distributions of the processors of the VMs */
+#define UNIFORM_DISTRIBUTION 0
+#define SKEWED_DISTRIBUTION 1
+
+/* parameters of a synthetic datacenter */
+struct generator_parameters
+{
+	int h_size;
+	int v_size;
+	/* part of the VMs that run critical services, from 0 to 1 */
+	float critical_ratio;
+	/* processors of the VMs over processors of the PMs, over 1 with over subscription */
+	float load_factor;
+	int distribution;
+	unsigned long long seed;
+};
+
+/* function headers definitions */
+void generator_defaults(struct generator_parameters *parameters, int h_size, int v_size);
+int generate_datacenter(char path_to_file[], struct generator_parameters *parameters);
+
+#endif
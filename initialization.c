@@ -20,12 +20,15 @@
  * parameter: number of physical machines
  * parameter: number of virtual machines
  * parameter: virtual machines requirements matrix
- * returns: population matrix
+ * parameter: random number stream
+ * parameter: arena to take the population from, or NULL to use malloc
+ * returns: population
 */
-int **initialization(int number_of_individuals, int h_size, int v_size, int **V, int CRITICAL_SERVICES)
+struct population *initialization(int number_of_individuals, int h_size, int v_size, int **V, int CRITICAL_SERVICES, struct rng *rng, struct arena *arena)
 {
-	// population: initial population matrix 
-	int **population = (int **) malloc (number_of_individuals *sizeof (int *));
+	// population: initial population, stored in one block
+	struct population *population = population_create(number_of_individuals, v_size, arena);
+	int *individual;
 
 	// iterators 
 	int iterator_individual;
@@ -34,22 +37,22 @@ int **initialization(int number_of_individuals, int h_size, int v_size, int **V,
 	// iterate on individuals 
 	for (iterator_individual=0; iterator_individual < number_of_individuals; iterator_individual++)
 	{
-		population[iterator_individual] = (int *) malloc (v_size *sizeof (int));
+		individual = INDIVIDUAL(population, iterator_individual);
 
 		// iterate on positions of an individual 
 		for (iterator_individual_position = 0; iterator_individual_position < v_size; iterator_individual_position++)
 		{
 			// VM with no CRITICAL_SERVICES 
-			if (V[iterator_individual_position][3] != CRITICAL_SERVICES)
+			if (V[3][iterator_individual_position] != CRITICAL_SERVICES)
 			{
 				// assign to a no critical virtual machine a random generated physical machine from 0 to h_size
-				population[iterator_individual][iterator_individual_position] = generate_solution_position(h_size, 0);
+				individual[iterator_individual_position] = generate_solution_position(h_size, 0, rng);
 			}
 			// VM with CRITICAL_SERVICES
-			if (V[iterator_individual_position][3] == CRITICAL_SERVICES)
+			if (V[3][iterator_individual_position] == CRITICAL_SERVICES)
 			{
 				// assign to a critical virtual machine a random generated physical machine from 1 to h_size
-				population[iterator_individual][iterator_individual_position] = generate_solution_position(h_size, 1);
+				individual[iterator_individual_position] = generate_solution_position(h_size, 1, rng);
 			}
 		}
 	}
@@ -60,20 +63,21 @@ int **initialization(int number_of_individuals, int h_size, int v_size, int **V,
 /* generate_solution_position: generates a host number between 0 or 1 and parameter max_posible
  * parameter: maximun number for the randon number to return
  * parameter: if VM is critical (1) or not (0). For critical VMs, the placement is mandatory.
+ * parameter: random number stream
  * returns: random number between 0 and parameter max_posible
 */
-int generate_solution_position(int max_posible, int CRITICAL)
+int generate_solution_position(int max_posible, int CRITICAL, struct rng *rng)
 {
 	/* assign to each virtual machine a random generated physical machine from 0 to the maximum possible */
 	if (CRITICAL == 0)
 	{
 		/* integer from 0 to max_posible + 1*/
-		return rand() % (max_posible + 1);
+		return rng_bounded(rng, max_posible + 1);
 	} 
 	/* assign to each virtual machine a random generated physical machine from 1 to the maximum possible */
 	if (CRITICAL == 1)
 	{
 		/* integer from 1 to max_posible */
-		return rand() % max_posible + 1;
+		return rng_bounded(rng, max_posible) + 1;
 	} 
 }
@@ -17,6 +17,9 @@
 #include <math.h>
 #include <time.h>
 
+#include "population.h"
+#include "rng.h"
+
 /* function headers definitions */
-int** initialization(int number_of_individuals, int h_size, int v_size, int **V, int CRITICAL_SERVICES);
-int generate_solution_position(int max_posible, int CRITICAL);
+struct population *initialization(int number_of_individuals, int h_size, int v_size, int **V, int CRITICAL_SERVICES, struct rng *rng, struct arena *arena);
+int generate_solution_position(int max_posible, int CRITICAL, struct rng *rng);
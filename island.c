@@ -0,0 +1,406 @@
+/*
+ * island.c: Virtual Machine Placement with OverSubscription Problem - Island Model
+ * Date: 17-10-2026
+ *
+ * An island changes only its own state during a generation, and the migration and the merge
+ * of the archives run in the calling thread between the generations, so the results of a run
+ * do not depend on the number of threads.
+*/
+
+/* include island model header */
+#include "island.h"
+#include "common.h"
+#include "initialization.h"
+#include "commitment.h"
+#include "reparation.h"
+#include "local_search.h"
+#include "variation.h"
+#include "evaluation.h"
+#include "offspring.h"
+#include "pareto.h"
+
+/* position of an individual in the order of the migration */
+struct island_rank
+{
+	int front;
+	int individual;
+};
+
+/* data of the generations of the islands run by the thread pool */
+struct islands_data
+{
+	struct island **islands;
+	int number_of_generations;
+};
+
+/* island_create: creates an island with its initial population P_0, repaired, improved and evaluated
+ * parameter: solver context, with the datacenter, the base solution and the stream that gives the stream of the island
+ * parameter: number of physical machines used by the individuals of P_0
+ * returns: island
+*/
+struct island *island_create(struct vmpos_context *context, int initial_h_size)
+{
+	int iterator_individual;
+	int **H = context->datacenter->H;
+	int **V = context->datacenter->V;
+	int number_of_individuals = context->total_of_individuals;
+	int h_size = context->datacenter->h_size;
+	int v_size = context->datacenter->v_size;
+	int repair_h_size = context->pm_used_in_base_individual;
+	int CRITICAL_SERVICES = context->CRITICAL_SERVICES;
+	struct rng *streams;
+	struct island *island = (struct island *) malloc (sizeof (struct island));
+
+	if (island == NULL)
+	{
+		printf ("[ERROR]: Problem with memory space. Function malloc returned NULL!\n");
+		exit (EXIT_FAILURE);
+	}
+
+	island->context = context;
+	island->H = H;
+	island->V = V;
+	island->number_of_individuals = number_of_individuals;
+	island->h_size = h_size;
+	island->v_size = v_size;
+	island->repair_h_size = repair_h_size;
+	island->CRITICAL_SERVICES = CRITICAL_SERVICES;
+	rng_split(&context->rng, &island->rng);
+
+	island->h_sizes = (int *) malloc (number_of_individuals * sizeof (int));
+
+	if (island->h_sizes == NULL)
+	{
+		printf ("[ERROR]: Problem with memory space. Function malloc returned NULL!\n");
+		exit (EXIT_FAILURE);
+	}
+
+	for (iterator_individual = 0; iterator_individual < number_of_individuals; iterator_individual++)
+		island->h_sizes[iterator_individual] = repair_h_size;
+
+	/* arena for the temporaries of a generation: Q, CM_Q, objectives and fronts of Q and the P union Q of the evolution.
+	   It is sized for one generation and grows by itself if that is not enough */
+	island->arena = arena_create( (size_t) number_of_individuals * (3 * (size_t) v_size + 4 * (size_t) h_size + 16) * sizeof(int) );
+
+	/*******************************************/
+	/*    Initialize population P_0 	       */
+	/*******************************************/
+	PROFILE_START(timer);
+	island->P = initialization(number_of_individuals, initial_h_size, v_size, V, CRITICAL_SERVICES, &island->rng, NULL);
+	PROFILE_LAP(context, PROFILE_INITIALIZATION, timer);
+
+	/* CM: Commitment Matrix. Has the level of commitment for each PM in each individal */
+	island->CM = calculates_commitment(context, island->P, number_of_individuals, h_size, v_size, V, CRITICAL_SERVICES, NULL);
+	PROFILE_LAP(context, PROFILE_COMMITMENT, timer);
+
+	/* Additional task: load the utilization of physical machines of all individuals/solutions */
+	load_utilization(island->P, H, V, number_of_individuals, h_size, v_size);
+	PROFILE_LAP(context, PROFILE_UTILIZATION, timer);
+
+	/* partial sums of the objective functions, kept up to date on every move of the repair and local search */
+	load_evaluation(context, island->P, island->CM, H, V, number_of_individuals, h_size, v_size, CRITICAL_SERVICES);
+	PROFILE_LAP(context, PROFILE_EVALUATION, timer);
+
+	/************************************************/
+	/*     P0’ = repair infeasible solutions of P_0 */
+	/************************************************/
+	streams = load_streams(&island->rng, number_of_individuals, NULL);
+	repair_population(context, island->P, island->CM, H, V, island->h_sizes, number_of_individuals, initial_h_size, v_size, CRITICAL_SERVICES, streams);
+	free(streams);
+	PROFILE_LAP(context, PROFILE_REPARATION, timer);
+
+	/******************************************************/
+	/*     P0’’ = apply local search to solutions of P_0’ */
+	/******************************************************/
+	local_search(context, island->P, island->CM, H, V, island->h_sizes, number_of_individuals, h_size, v_size, CRITICAL_SERVICES);
+	PROFILE_LAP(context, PROFILE_LOCAL_SEARCH, timer);
+
+	/* Additional task: calculate the cost of each objective function for each solution */
+	island->objectives_functions = load_objectives(context, island->P, island->CM, H, V, number_of_individuals, h_size, v_size, context->base_solution, CRITICAL_SERVICES, NULL);
+	PROFILE_LAP(context, PROFILE_OBJECTIVES, timer);
+
+	/* Additional task: calculate the non-dominated fronts according to NSGA-II */
+	island->fronts = non_dominated_sorting(island->objectives_functions, number_of_individuals, NULL);
+	PROFILE_LAP(context, PROFILE_SORTING, timer);
+
+	/**********************************************************/
+	/*    Update set of nondominated solutions Pc from P_0’’  */
+	/**********************************************************/
+	island->archive = pareto_create(context, v_size, context->archive_max_size);
+
+	/* considering that the P_c is empty at first population, each non-dominated solution from first front is added */
+	for (iterator_individual = 0; iterator_individual < number_of_individuals; iterator_individual++)
+	{
+		if (island->fronts[iterator_individual] == 1)
+			pareto_insert(island->archive, INDIVIDUAL(island->P, iterator_individual), island->objectives_functions[iterator_individual]);
+	}
+	PROFILE_LAP(context, PROFILE_PARETO, timer);
+
+	return island;
+}
+
+/* island_generation: a generation of the memetic algorithm in an island
+ * parameter: island
+ * parameter: thread pool for the offspring pipeline, or NULL to process the individuals in the calling thread
+ * returns: nothing, it's void
+*/
+void island_generation(struct island *island, struct thread_pool *pool)
+{
+	int iterator_individual;
+	int n = island->number_of_individuals;
+	int father, mother;
+	struct population *Q;
+	float **CM_Q;
+	float **objectives_functions_Q;
+	int *fronts_Q;
+
+	/* Additional task: Q is a random generated population, lets initialize it */
+	PROFILE_START(timer);
+	Q = initialization(n, island->repair_h_size, island->v_size, island->V, island->CRITICAL_SERVICES, &island->rng, island->arena);
+	PROFILE_LAP(island->context, PROFILE_INITIALIZATION, timer);
+
+	/* Q_t = selection of solutions from P_t ∪ P_c */
+	father = selection(island->fronts, n, SELECTION_PERCENT, &island->rng);
+	mother = selection(island->fronts, n, SELECTION_PERCENT, &island->rng);
+
+	while (father == mother)
+	{
+		mother = selection(island->fronts, n, SELECTION_PERCENT, &island->rng);
+	}
+
+	/* Q_t’ = crossover of solutions of Q_t */
+	crossover(Q, father, mother, island->v_size);
+	PROFILE_LAP(island->context, PROFILE_CROSSOVER, timer);
+
+	/* Additional task: load the utilization of physical machines of all individuals/solutions */
+	load_utilization(Q, island->H, island->V, n, island->h_size, island->v_size);
+	PROFILE_LAP(island->context, PROFILE_UTILIZATION, timer);
+
+	/* CM_Q: the mutation, repair and local search keep it up to date on every move of a virtual machine */
+	CM_Q = calculates_commitment(island->context, Q, n, island->h_size, island->v_size, island->V, island->CRITICAL_SERVICES, island->arena);
+	PROFILE_LAP(island->context, PROFILE_COMMITMENT, timer);
+
+	/* Additional task: partial sums of the objective functions, so they are not recalculated after the local search */
+	load_evaluation(island->context, Q, CM_Q, island->H, island->V, n, island->h_size, island->v_size, island->CRITICAL_SERVICES);
+	PROFILE_LAP(island->context, PROFILE_EVALUATION, timer);
+
+	/* Q_t’ = mutation of solutions of Q_t, Q_t’’ = repair infeasible solutions of Q_t’, Q_t’’’ = apply local search to solutions of Q_t’’
+	   and calculate the cost of each objective function for each solution, each individual in a task of the thread pool */
+	objectives_functions_Q = offspring(island->context, pool, Q, CM_Q, island->H, island->V, island->h_sizes, n, island->h_size, island->repair_h_size, island->v_size, island->CRITICAL_SERVICES, &island->rng, island->arena);
+	PROFILE_LAP(island->context, PROFILE_OFFSPRING, timer);
+
+	/* Additional task: calculate the non-dominated fronts according to NSGA-II */
+	fronts_Q = non_dominated_sorting(objectives_functions_Q, n, island->arena);
+	PROFILE_LAP(island->context, PROFILE_SORTING, timer);
+
+	/* Update set of nondominated solutions Pc from Qt’’’ */
+	for (iterator_individual = 0; iterator_individual < n; iterator_individual++)
+	{
+		if (fronts_Q[iterator_individual] == 1)
+			pareto_insert(island->archive, INDIVIDUAL(Q, iterator_individual), objectives_functions_Q[iterator_individual]);
+	}
+	PROFILE_LAP(island->context, PROFILE_PARETO, timer);
+
+	/* Pt = fitness selection from Pt ∪ Qt’’’ */
+	population_evolution(island->P, Q, island->objectives_functions, objectives_functions_Q, island->fronts, n, island->v_size, island->arena);
+
+	/* the archive keeps copies of its solutions, all the temporaries of the generation are released at once */
+	arena_reset(island->arena);
+	PROFILE_LAP(island->context, PROFILE_EVOLUTION, timer);
+}
+
+/* islands_task: some generations of one island, a task of the thread pool
+ * parameter: data of the generations
+ * parameter: identificator of the island
+ * parameter: worker that runs the task
+ * returns: nothing, it's void
+*/
+static void islands_task(void *data, int island, int worker)
+{
+	struct islands_data *epoch = (struct islands_data *) data;
+	int iterator_generation;
+
+	/* the islands run in parallel, so the individuals of an island are processed in its thread */
+	for (iterator_generation = 0; iterator_generation < epoch->number_of_generations; iterator_generation++)
+		island_generation(epoch->islands[island], NULL);
+}
+
+/* islands_evolution: some generations of all the islands, each island in a task of the thread pool
+ * parameter: thread pool
+ * parameter: islands
+ * parameter: number of islands
+ * parameter: number of generations
+ * returns: nothing, it's void
+*/
+void islands_evolution(struct thread_pool *pool, struct island **islands, int number_of_islands, int number_of_generations)
+{
+	struct islands_data epoch;
+
+	epoch.islands = islands;
+	epoch.number_of_generations = number_of_generations;
+
+	thread_pool_run(pool, number_of_islands, islands_task, &epoch);
+}
+
+/* compare_rank: order of the individuals by front, and by identificator in the same front
+ * parameter: first rank
+ * parameter: second rank
+ * returns: negative, zero or positive as the first goes before, with or after the second
+*/
+static int compare_rank(const void *first, const void *second)
+{
+	const struct island_rank *a = (const struct island_rank *) first;
+	const struct island_rank *b = (const struct island_rank *) second;
+
+	if (a->front != b->front)
+		return a->front - b->front;
+
+	return a->individual - b->individual;
+}
+
+/* island_migration: the best individuals of each island replace the worst individuals of the next island
+ * parameter: islands
+ * parameter: number of islands
+ * parameter: number of individuals sent by each island, at most half of the population
+ * parameter: RING_TOPOLOGY sends to the next island, RANDOM_TOPOLOGY to the next island of a random ring
+ * parameter: random number stream for the random ring
+ * returns: nothing, it's void
+*/
+void island_migration(struct island **islands, int number_of_islands, int number_of_migrants, int topology, struct rng *rng)
+{
+	/* iterators */
+	int iterator_island, iterator_migrant, iterator_individual;
+
+	int n = islands[0]->number_of_individuals;
+	int v_size = islands[0]->v_size;
+	int source, destination, swap, position;
+	int *order, *fronts;
+	struct island_rank *ranks;
+	struct population *migrants;
+	float *migrants_objectives;
+
+	if (number_of_migrants > n / 2)
+		number_of_migrants = n / 2;
+
+	if (number_of_islands < 2 || number_of_migrants < 1)
+		return;
+
+	PROFILE_START(timer);
+
+	order = (int *) malloc (number_of_islands * sizeof (int));
+	ranks = (struct island_rank *) malloc ((size_t) number_of_islands * n * sizeof (struct island_rank));
+	migrants_objectives = (float *) malloc ((size_t) number_of_islands * number_of_migrants * 3 * sizeof (float));
+
+	if (order == NULL || ranks == NULL || migrants_objectives == NULL)
+	{
+		printf ("[ERROR]: Problem with memory space. Function malloc returned NULL!\n");
+		exit (EXIT_FAILURE);
+	}
+
+	migrants = population_create(number_of_islands * number_of_migrants, v_size, NULL);
+
+	/* the ring of the islands, shuffled for the random topology so each island still receives from only one island */
+	for (iterator_island = 0; iterator_island < number_of_islands; iterator_island++)
+		order[iterator_island] = iterator_island;
+
+	if (topology == RANDOM_TOPOLOGY)
+	{
+		for (iterator_island = number_of_islands - 1; iterator_island > 0; iterator_island--)
+		{
+			position = rng_bounded(rng, iterator_island + 1);
+			swap = order[iterator_island];
+			order[iterator_island] = order[position];
+			order[position] = swap;
+		}
+	}
+
+	/* all the migrants leave before any arrives, so a migrant does not travel twice */
+	for (iterator_island = 0; iterator_island < number_of_islands; iterator_island++)
+	{
+		struct island_rank *rank = ranks + (size_t) iterator_island * n;
+
+		for (iterator_individual = 0; iterator_individual < n; iterator_individual++)
+		{
+			rank[iterator_individual].front = islands[iterator_island]->fronts[iterator_individual];
+			rank[iterator_individual].individual = iterator_individual;
+		}
+		qsort(rank, n, sizeof (struct island_rank), compare_rank);
+
+		for (iterator_migrant = 0; iterator_migrant < number_of_migrants; iterator_migrant++)
+		{
+			position = iterator_island * number_of_migrants + iterator_migrant;
+			population_copy_individual(migrants, position, islands[iterator_island]->P, rank[iterator_migrant].individual);
+			memcpy(migrants_objectives + (size_t) position * 3, islands[iterator_island]->objectives_functions[rank[iterator_migrant].individual], 3 * sizeof (float));
+		}
+	}
+
+	/* the migrants take the places of the last individuals of the worst fronts */
+	for (iterator_island = 0; iterator_island < number_of_islands; iterator_island++)
+	{
+		source = order[iterator_island];
+		destination = order[(iterator_island + 1) % number_of_islands];
+
+		for (iterator_migrant = 0; iterator_migrant < number_of_migrants; iterator_migrant++)
+		{
+			position = source * number_of_migrants + iterator_migrant;
+			iterator_individual = ranks[(size_t) destination * n + n - 1 - iterator_migrant].individual;
+
+			population_copy_individual(islands[destination]->P, iterator_individual, migrants, position);
+			memcpy(islands[destination]->objectives_functions[iterator_individual], migrants_objectives + (size_t) position * 3, 3 * sizeof (float));
+		}
+	}
+
+	/* the fronts of P are sorted again with the migrants */
+	for (iterator_island = 0; iterator_island < number_of_islands; iterator_island++)
+	{
+		fronts = non_dominated_sorting(islands[iterator_island]->objectives_functions, n, NULL);
+		memcpy(islands[iterator_island]->fronts, fronts, n * sizeof (int));
+		free(fronts);
+	}
+
+	population_free(migrants);
+	free(migrants_objectives);
+	free(ranks);
+	free(order);
+	PROFILE_LAP(islands[0]->context, PROFILE_MIGRATION, timer);
+}
+
+/* islands_merge: inserts the solutions of the archives of all the islands in one archive
+ * parameter: islands
+ * parameter: number of islands
+ * parameter: Pareto archive
+ * returns: nothing, it's void
+*/
+void islands_merge(struct island **islands, int number_of_islands, struct pareto_archive *archive)
+{
+	int iterator_island, iterator_element;
+	struct pareto_archive *island_archive;
+
+	PROFILE_START(timer);
+	for (iterator_island = 0; iterator_island < number_of_islands; iterator_island++)
+	{
+		island_archive = islands[iterator_island]->archive;
+
+		for (iterator_element = 0; iterator_element < island_archive->size; iterator_element++)
+			pareto_insert(archive, island_archive->elements[iterator_element].solution, island_archive->elements[iterator_element].costs);
+	}
+	PROFILE_LAP(islands[0]->context, PROFILE_PARETO, timer);
+}
+
+/* free_island: frees an island
+ * parameter: island
+ * returns: nothing, it's void
+*/
+void free_island(struct island *island)
+{
+	free_pareto_archive(island->archive);
+	population_free(island->P);
+	free(island->CM[0]);
+	free(island->CM);
+	free(island->objectives_functions[0]);
+	free(island->objectives_functions);
+	free(island->fronts);
+	free(island->h_sizes);
+	arena_free(island->arena);
+	free(island);
+}
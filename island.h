@@ -0,0 +1,68 @@
+/*
+ * island.h: Virtual Machine Placement with OverSubscription Problem - Island Model Header
+ * Date: 17-10-2026
+ *
+ * An island is one run of the memetic algorithm: its own population P, the commitment matrix,
+ * objective functions and fronts of P, the PMs usable by each individual, its Pareto archive,
+ * random number stream and generation arena. The islands share only the datacenter and the
+ * base solution, which they do not change, so they evolve on different threads without locks.
+ * Every few generations the best individuals of each island replace the worst individuals of
+ * another island, in a ring or to a random island, and the archives of all the islands are
+ * merged in one Pareto front.
+*/
+
+#ifndef ISLAND_H
+#define ISLAND_H
+
+#include "population.h"
+#include "thread_pool.h"
+#include "rng.h"
+#include "context.h"
+
+/* part of the first fronts of P where the parents of the crossover are selected */
+#define SELECTION_PERCENT 0.5
+
+/* topologies of the migration */
+#define RING_TOPOLOGY 0
+#define RANDOM_TOPOLOGY 1
+
+struct pareto_archive;
+
+/* structure of an island */
+struct island
+{
+	/* solver context, datacenter and sizes, shared by all the islands */
+	struct vmpos_context *context;
+	int **H;
+	int **V;
+	int number_of_individuals;
+	int h_size;
+	int v_size;
+	/* number of physical machines of the base solution, used by the new individuals and verified by the repair */
+	int repair_h_size;
+	int CRITICAL_SERVICES;
+
+	/* population P, its commitment matrix, the cost of each objective function and the fronts of its individuals */
+	struct population *P;
+	float **CM;
+	float **objectives_functions;
+	int *fronts;
+	/* number of physical machines usable by each individual */
+	int *h_sizes;
+
+	/* non-dominated solutions found by the island */
+	struct pareto_archive *archive;
+	struct rng rng;
+	/* temporaries of a generation */
+	struct arena *arena;
+};
+
+/* function headers definitions */
+struct island *island_create(struct vmpos_context *context, int initial_h_size);
+void island_generation(struct island *island, struct thread_pool *pool);
+void islands_evolution(struct thread_pool *pool, struct island **islands, int number_of_islands, int number_of_generations);
+void island_migration(struct island **islands, int number_of_islands, int number_of_migrants, int topology, struct rng *rng);
+void islands_merge(struct island **islands, int number_of_islands, struct pareto_archive *archive);
+void free_island(struct island *island);
+
+#endif
@@ -15,110 +15,117 @@
 #include "local_search.h"
 #include "commitment.h"
 #include "common.h"
+#include "evaluation.h"
 
 /* local_search: local optimization of the population
- * parameter: population matrix
- * parameter: utilization matrix of the physical machines of all the individuals
+ * parameter: solver context
+ * parameter: population, with its utilization and evaluation loaded
  * parameter: commitment matrix
  * parameter: physical machines matrix
  * parameter: virtual machines matrix
+ * parameter: number of physical machines usable by each individual
  * parameter: number of individuals
  * parameter: number of physical machines
  * parameter: number of virtual machines
- * returns: optimized population matrix
+ * returns: nothing, it's void
 */
-void local_search(int **population, int ***utilization, float **cm, int **H, int **V, int number_of_individuals, int h_size, int v_size, int CRITICAL_SERVICES)
+void local_search(struct vmpos_context *context, struct population *population, float **cm, int **H, int **V, int *h_sizes, int number_of_individuals, int h_size, int v_size, int CRITICAL_SERVICES)
+{
+	int iterator_individual;
+
+	/* iterate on individuals */
+	for (iterator_individual = 0 ; iterator_individual < number_of_individuals ; iterator_individual++)
+		local_search_individual(context, population, cm, H, V, h_sizes, h_size, v_size, CRITICAL_SERVICES, iterator_individual);
+}
+
+/* local_search_individual: local optimization of one individual, it only changes the state of this individual
+ * parameter: solver context
+ * parameter: population, with its utilization and evaluation loaded
+ * parameter: commitment matrix
+ * parameter: physical machines matrix
+ * parameter: virtual machines matrix
+ * parameter: number of physical machines usable by each individual
+ * parameter: number of physical machines
+ * parameter: number of virtual machines
+ * parameter: identificator of the individual to optimize
+ * returns: nothing, it's void
+*/
+void local_search_individual(struct vmpos_context *context, struct population *population, float **cm, int **H, int **V, int *h_sizes, int h_size, int v_size, int CRITICAL_SERVICES, int individual)
 {
 	/* iterators */
-	int iterator_individual = 0;
 	int physical_position = 0;
 	int physical_position2 = 0;
 	int iterator_position = 0;
 	int iterator_virtual = 0;
 	int iterator_virtual2 = 0;
+	int next_virtual = 0;
 	int iterator_physical = 0;
 
 	float available_cpus = 0.0, available_memory = 0.0;
 	int allocated_vm, physical_turned_off = 0;
+	int *genes = INDIVIDUAL(population, individual);
 
 	/*  try to place the virtual machines turned off in the physical machines turned on */
 
-	/* iterate on individuals */
-	for (iterator_individual = 0 ; iterator_individual < number_of_individuals ; iterator_individual++)
+	/* iterate on the virtual machines not placed */
+	for (iterator_virtual = FIRST_VIRTUAL_MACHINE(population, individual, 0) ; iterator_virtual != -1 ; iterator_virtual = next_virtual)
 	{
-		/* iterate on virtual machines */
-		for (iterator_virtual = 0 ; iterator_virtual < v_size ; iterator_virtual++)
-		{
+		next_virtual = NEXT_VIRTUAL_MACHINE(population, individual, iterator_virtual);
 
-			/* get the position of the physical machine */
-			physical_position = population[iterator_individual][iterator_virtual];
+		/* get the position of the physical machine */
+		physical_position = genes[iterator_virtual];
 
-			if (physical_position == 0)
+		if (physical_position == 0)
+		{
+			allocated_vm = 0;
+			
+			/* iterate on virtual machines */
+			for (iterator_virtual2 = 0 ; iterator_virtual2 < v_size ; iterator_virtual2++)
 			{
-				allocated_vm = 0;
-				
-				/* iterate on virtual machines */
-				for (iterator_virtual2 = 0 ; iterator_virtual2 < v_size ; iterator_virtual2++)
-				{
-					/* get the position of the physical machine */
-					physical_position2 = population[iterator_individual][iterator_virtual2];
+				/* get the position of the physical machine */
+				physical_position2 = genes[iterator_virtual2];
 
-					if (physical_position2 > 0)
+				if (physical_position2 > 0)
+				{
+					if (cm[individual][physical_position2-1] > 1.0)
 					{
-						if (cm[iterator_individual][physical_position2-1] > 1.0)
-						{
-							available_cpus = (float) H[physical_position2-1][0] * cm[iterator_individual][physical_position2-1];
-							available_memory = (float) H[physical_position2-1][1] * cm[iterator_individual][physical_position2-1];
-						}
-						else
-						{
-							available_cpus = (float) H[physical_position2-1][0];
-							available_memory = (float) H[physical_position2-1][1];
-						}
-						
-						/* If the use of the VM not exceeds the capacity of the physical machine performs the migration */
-						if ( (float) utilization[iterator_individual][physical_position2-1][0] + (float) V[iterator_virtual][0] <= available_cpus && 
-							 (float) utilization[iterator_individual][physical_position2-1][1] + (float) V[iterator_virtual][1] <= available_memory && 
-							 (float) utilization[iterator_individual][physical_position2-1][2] + (float) V[iterator_virtual][2] <= (float) H[physical_position2-1][2])
-						{
-							/* refresh the utilization */
-							utilization[iterator_individual][physical_position2-1][0] += V[iterator_virtual][0];
-							utilization[iterator_individual][physical_position2-1][1] += V[iterator_virtual][1];
-							utilization[iterator_individual][physical_position2-1][2] += V[iterator_virtual][2];
-							/* refresh the population */
-							population[iterator_individual][iterator_virtual] = population[iterator_individual][iterator_virtual2];
-
-							/* updte the commitment matrix */
-							update_commitment_line (population, cm, V, iterator_individual, h_size, v_size, CRITICAL_SERVICES);
+						available_cpus = (float) H[0][physical_position2-1] * cm[individual][physical_position2-1];
+						available_memory = (float) H[1][physical_position2-1] * cm[individual][physical_position2-1];
+					}
+					else
+					{
+						available_cpus = (float) H[0][physical_position2-1];
+						available_memory = (float) H[1][physical_position2-1];
+					}
+					
+					/* If the use of the VM not exceeds the capacity of the physical machine performs the migration */
+					if ( (float) UTILIZATION(population, individual, physical_position2-1)[0] + (float) V[0][iterator_virtual] <= available_cpus && 
+						 (float) UTILIZATION(population, individual, physical_position2-1)[1] + (float) V[1][iterator_virtual] <= available_memory && 
+						 (float) UTILIZATION(population, individual, physical_position2-1)[2] + (float) V[2][iterator_virtual] <= (float) H[2][physical_position2-1])
+					{
+						/* refresh the utilization, the population and the commitment matrix */
+						move_virtual_machine(context, population, cm, H, V, individual, iterator_virtual, genes[iterator_virtual2], CRITICAL_SERVICES);
 
-							/* The vm was aloccated */
-							allocated_vm = 1;
-							break;
-						}
+						/* The vm was aloccated */
+						allocated_vm = 1;
+						break;
 					}
 				}
+			}
 
-				/* The turned off VM was not alocatted. Try to find Physical Machine turned off */
-				if (!allocated_vm)
-				{
-					if ( global_h_sizes[iterator_individual] < h_size )
-						global_h_sizes[iterator_individual]++;
+			/* The turned off VM was not alocatted. Try to find Physical Machine turned off */
+			if (!allocated_vm)
+			{
+				if ( h_sizes[individual] < h_size )
+					h_sizes[individual]++;
 
-					for (physical_turned_off = 0; physical_turned_off < global_h_sizes[iterator_individual]; physical_turned_off++)
+				for (physical_turned_off = 0; physical_turned_off < h_sizes[individual]; physical_turned_off++)
+				{
+					if (cm[individual][physical_turned_off] == 0.0)
 					{
-						if (cm[iterator_individual][physical_turned_off] == 0.0)
-						{
-							/* refresh the utilization */
-							utilization[iterator_individual][physical_turned_off][0] += V[iterator_virtual][0];
-							utilization[iterator_individual][physical_turned_off][1] += V[iterator_virtual][1];
-							utilization[iterator_individual][physical_turned_off][2] += V[iterator_virtual][2];
-							/* refresh the population */
-							population[iterator_individual][iterator_virtual] = physical_turned_off + 1;
-
-							/* updte the commitment matrix */
-							update_commitment_line (population, cm, V, iterator_individual, h_size, v_size, CRITICAL_SERVICES);
-							break;
-						}
+						/* refresh the utilization, the population and the commitment matrix */
+						move_virtual_machine(context, population, cm, H, V, individual, iterator_virtual, physical_turned_off + 1, CRITICAL_SERVICES);
+						break;
 					}
 				}
 			}
@@ -128,59 +135,44 @@ void local_search(int **population, int ***utilization, float **cm, int **H, int
 	/* comes of shut down physical machines to the migrate in other virtual machines */
 
 	/* Concentrating VMs WITH NO Critical Services */
-	/* iterate on individuals */
-	for (iterator_individual = 0 ; iterator_individual < number_of_individuals ; iterator_individual++)
+	/* iterate on virtual machines */
+	for (iterator_virtual = 0 ; iterator_virtual < v_size ; iterator_virtual++)
 	{
-		/* iterate on virtual machines */
-		for (iterator_virtual = 0 ; iterator_virtual < v_size ; iterator_virtual++)
+		if (V[3][iterator_virtual] != CRITICAL_SERVICES)
 		{
-			if (V[iterator_virtual][3] != CRITICAL_SERVICES)
+			/* get the position of the physical machine */
+			physical_position = genes[iterator_virtual];
+
+			if (physical_position > 0)
 			{
-				/* get the position of the physical machine */
-				physical_position = population[iterator_individual][iterator_virtual];
+				if (cm[individual][physical_position-1] > 1.0)
+				{
+					available_cpus = (float) H[0][physical_position-1] * cm[individual][physical_position-1];
+					available_memory = (float) H[1][physical_position-1] * cm[individual][physical_position-1];
+				}
+				else
+				{
+					available_cpus = (float) H[0][physical_position-1];
+					available_memory = (float) H[1][physical_position-1];
+				}
 
-				if (physical_position > 0)
+				/* iterate on virtual machines */
+				for (iterator_virtual2 = 0 ; iterator_virtual2 < v_size ; iterator_virtual2++)
 				{
-					if (cm[iterator_individual][physical_position-1] > 1.0)
-					{
-						available_cpus = (float) H[physical_position-1][0] * cm[iterator_individual][physical_position-1];
-						available_memory = (float) H[physical_position-1][1] * cm[iterator_individual][physical_position-1];
-					}
-					else
+					if (V[3][iterator_virtual2] != CRITICAL_SERVICES)
 					{
-						available_cpus = (float) H[physical_position-1][0];
-						available_memory = (float) H[physical_position-1][1];
-					}
+						/* get the position of the physical machine */
+						physical_position2 = genes[iterator_virtual2];
 
-					/* iterate on virtual machines */
-					for (iterator_virtual2 = 0 ; iterator_virtual2 < v_size ; iterator_virtual2++)
-					{
-						if (V[iterator_virtual2][3] != CRITICAL_SERVICES)
+						if (physical_position != physical_position2 && physical_position2 > 0)
 						{
-							/* get the position of the physical machine */
-							physical_position2 = population[iterator_individual][iterator_virtual2];
-
-							if (physical_position != physical_position2 && physical_position2 > 0)
+							/* If the use of the VM not exceeds the capacity of the physical machine performs the migration */
+							if ((float) UTILIZATION(population, individual, physical_position-1)[0] + (float) V[0][iterator_virtual2] <= available_cpus && 
+								(float) UTILIZATION(population, individual, physical_position-1)[1] + (float) V[1][iterator_virtual2] <= available_memory && 
+								(float) UTILIZATION(population, individual, physical_position-1)[2] + (float) V[2][iterator_virtual2] <= (float) H[2][physical_position-1])
 							{
-								/* If the use of the VM not exceeds the capacity of the physical machine performs the migration */
-								if ((float) utilization[iterator_individual][physical_position-1][0] + (float) V[iterator_virtual2][0] <= available_cpus && 
-									(float) utilization[iterator_individual][physical_position-1][1] + (float) V[iterator_virtual2][1] <= available_memory && 
-									(float) utilization[iterator_individual][physical_position-1][2] + (float) V[iterator_virtual2][2] <= (float) H[physical_position-1][2])
-								{
-									/* refresh the utilization */
-									utilization[iterator_individual][physical_position2-1][0] -= V[iterator_virtual2][0];
-									utilization[iterator_individual][physical_position2-1][1] -= V[iterator_virtual2][1];
-									utilization[iterator_individual][physical_position2-1][2] -= V[iterator_virtual2][2];
-
-									utilization[iterator_individual][physical_position-1][0] += V[iterator_virtual2][0];
-									utilization[iterator_individual][physical_position-1][1] += V[iterator_virtual2][1];
-									utilization[iterator_individual][physical_position-1][2] += V[iterator_virtual2][2];
-									/* refresh the population */
-									population[iterator_individual][iterator_virtual2] = population[iterator_individual][iterator_virtual];
-
-									/* updte the commitment matrix */
-									update_commitment_line (population, cm, V, iterator_individual, h_size, v_size, CRITICAL_SERVICES);
-								}
+								/* refresh the utilization, the population and the commitment matrix */
+								move_virtual_machine(context, population, cm, H, V, individual, iterator_virtual2, genes[iterator_virtual], CRITICAL_SERVICES);
 							}
 						}
 					}
@@ -190,51 +182,36 @@ void local_search(int **population, int ***utilization, float **cm, int **H, int
 	}
 
 	/* Concentrating VMs WITH Critical Services */
-	/* iterate on individuals */
-	for (iterator_individual = 0 ; iterator_individual < number_of_individuals ; iterator_individual++)
+	/* iterate on virtual machines */
+	for (iterator_virtual = 0 ; iterator_virtual < v_size ; iterator_virtual++)
 	{
-		/* iterate on virtual machines */
-		for (iterator_virtual = 0 ; iterator_virtual < v_size ; iterator_virtual++)
+		if (V[3][iterator_virtual] == CRITICAL_SERVICES)
 		{
-			if (V[iterator_virtual][3] == CRITICAL_SERVICES)
+			/* get the position of the physical machine */
+			physical_position = genes[iterator_virtual];
+
+			if (physical_position > 0)
 			{
-				/* get the position of the physical machine */
-				physical_position = population[iterator_individual][iterator_virtual];
+				available_cpus = (float) H[0][physical_position-1];
+				available_memory = (float) H[1][physical_position-1];
 
-				if (physical_position > 0)
+				/* iterate on virtual machines */
+				for (iterator_virtual2 = 0 ; iterator_virtual2 < v_size ; iterator_virtual2++)
 				{
-					available_cpus = (float) H[physical_position-1][0];
-					available_memory = (float) H[physical_position-1][1];
-
-					/* iterate on virtual machines */
-					for (iterator_virtual2 = 0 ; iterator_virtual2 < v_size ; iterator_virtual2++)
+					if (V[3][iterator_virtual2] == CRITICAL_SERVICES)
 					{
-						if (V[iterator_virtual2][3] == CRITICAL_SERVICES)
-						{
-							/* get the position of the physical machine */
-							physical_position2 = population[iterator_individual][iterator_virtual2];
+						/* get the position of the physical machine */
+						physical_position2 = genes[iterator_virtual2];
 
-							if (physical_position != physical_position2)
+						if (physical_position != physical_position2)
+						{
+							/* If the use of the VM not exceeds the capacity of the physical machine performs the migration */
+							if ( (float) UTILIZATION(population, individual, physical_position-1)[0] + (float) V[0][iterator_virtual2] <= available_cpus && 
+								 (float) UTILIZATION(population, individual, physical_position-1)[1] + (float) V[1][iterator_virtual2] <= available_memory && 
+								 (float) UTILIZATION(population, individual, physical_position-1)[2] + (float) V[2][iterator_virtual2] <= (float) H[2][physical_position-1])
 							{
-								/* If the use of the VM not exceeds the capacity of the physical machine performs the migration */
-								if ( (float) utilization[iterator_individual][physical_position-1][0] + (float) V[iterator_virtual2][0] <= available_cpus && 
-									 (float) utilization[iterator_individual][physical_position-1][1] + (float) V[iterator_virtual2][1] <= available_memory && 
-									 (float) utilization[iterator_individual][physical_position-1][2] + (float) V[iterator_virtual2][2] <= (float) H[physical_position-1][2])
-								{
-									/* refresh the utilization */
-									utilization[iterator_individual][physical_position2-1][0] -= V[iterator_virtual2][0];
-									utilization[iterator_individual][physical_position2-1][1] -= V[iterator_virtual2][1];
-									utilization[iterator_individual][physical_position2-1][2] -= V[iterator_virtual2][2];
-
-									utilization[iterator_individual][physical_position-1][0] += V[iterator_virtual2][0];
-									utilization[iterator_individual][physical_position-1][1] += V[iterator_virtual2][1];
-									utilization[iterator_individual][physical_position-1][2] += V[iterator_virtual2][2];
-									/* refresh the population */
-									population[iterator_individual][iterator_virtual2] = population[iterator_individual][iterator_virtual];
-
-									/* updte the commitment matrix */
-									update_commitment_line (population, cm, V, iterator_individual, h_size, v_size, CRITICAL_SERVICES);
-								}
+								/* refresh the utilization, the population and the commitment matrix */
+								move_virtual_machine(context, population, cm, H, V, individual, iterator_virtual2, genes[iterator_virtual], CRITICAL_SERVICES);
 							}
 						}
 					}
@@ -247,96 +224,71 @@ void local_search(int **population, int ***utilization, float **cm, int **H, int
 
 	/* Now, we try to migrate VMs from PMs with just one or few VMs to another PM to shutdown one more PM */
 
-	//* iterate on individuals
-	for (iterator_individual = 0 ; iterator_individual < number_of_individuals ; iterator_individual++)
+	for (physical_position = 0; physical_position < h_sizes[individual]; physical_position++)
 	{
-		for (physical_position = 0; physical_position < global_h_sizes[iterator_individual]; physical_position++)
-		{
-			allocated_vm = 0;
+		allocated_vm = 0;
 
-			/* Verifying if the utilization is less than 10% and bigger than zero */
-			if ( (float) utilization[iterator_individual][physical_position][0] <= ((float) H[physical_position][0] / 10.0) && ( utilization[iterator_individual][physical_position][0] > 0 ) )
+		/* Verifying if the utilization is less than 10% and bigger than zero */
+		if ( (float) UTILIZATION(population, individual, physical_position)[0] <= ((float) H[0][physical_position] / 10.0) && ( UTILIZATION(population, individual, physical_position)[0] > 0 ) )
+		{
+			/* iterate on the virtual machines of the physical machine */
+			for (iterator_virtual = FIRST_VIRTUAL_MACHINE(population, individual, physical_position+1) ; iterator_virtual != -1 ; iterator_virtual = next_virtual)
 			{
-				for (iterator_virtual = 0 ; iterator_virtual < v_size ; iterator_virtual++)
+				next_virtual = NEXT_VIRTUAL_MACHINE(population, individual, iterator_virtual);
+
+				if ( (V[3][iterator_virtual] == CRITICAL_SERVICES) && (genes[iterator_virtual]-1 == physical_position) )
 				{
-					if ( (V[iterator_virtual][3] == CRITICAL_SERVICES) && (population[iterator_individual][iterator_virtual]-1 == physical_position) )
+					for (physical_position2 = 0 ; physical_position2 < h_sizes[individual] ; physical_position2++)
 					{
-						for (physical_position2 = 0 ; physical_position2 < global_h_sizes[iterator_individual] ; physical_position2++)
+						available_cpus = (float) H[0][physical_position2];
+						available_memory = (float) H[1][physical_position2];
+						
+						if (physical_position2 != physical_position && cm[individual][physical_position2] == context->cl_cs )
 						{
-							available_cpus = (float) H[physical_position2][0];
-							available_memory = (float) H[physical_position2][1];
-							
-							if (physical_position2 != physical_position && cm[iterator_individual][physical_position2] == cl_cs )
+							/* If the use of the VM not exceeds the capacity of the physical machine performs the migration */
+							if ( (float) UTILIZATION(population, individual, physical_position2)[0] + (float) V[0][iterator_virtual] <= available_cpus && 
+								 (float) UTILIZATION(population, individual, physical_position2)[1] + (float) V[1][iterator_virtual] <= available_memory && 
+								 (float) UTILIZATION(population, individual, physical_position2)[2] + (float) V[2][iterator_virtual] <= (float) H[2][physical_position2])
 							{
-								/* If the use of the VM not exceeds the capacity of the physical machine performs the migration */
-								if ( (float) utilization[iterator_individual][physical_position2][0] + (float) V[iterator_virtual][0] <= available_cpus && 
-									 (float) utilization[iterator_individual][physical_position2][1] + (float) V[iterator_virtual][1] <= available_memory && 
-									 (float) utilization[iterator_individual][physical_position2][2] + (float) V[iterator_virtual][2] <= (float) H[physical_position2][2])
-								{
-									/* refresh the utilization */
-									utilization[iterator_individual][physical_position][0] -= V[iterator_virtual][0];
-									utilization[iterator_individual][physical_position][1] -= V[iterator_virtual][1];
-									utilization[iterator_individual][physical_position][2] -= V[iterator_virtual][2];
-
-									utilization[iterator_individual][physical_position2][0] += V[iterator_virtual][0];
-									utilization[iterator_individual][physical_position2][1] += V[iterator_virtual][1];
-									utilization[iterator_individual][physical_position2][2] += V[iterator_virtual][2];
-									
-									/* refresh the population */
-									population[iterator_individual][iterator_virtual] = physical_position2+1;
+								/* refresh the utilization, the population and the commitment matrix */
+								move_virtual_machine(context, population, cm, H, V, individual, iterator_virtual, physical_position2+1, CRITICAL_SERVICES);
 
-									/* updte the commitment matrix */
-									update_commitment_line (population, cm, V, iterator_individual, h_size, v_size, CRITICAL_SERVICES);
-
-									allocated_vm = 1;
-									break;
-								}
+								allocated_vm = 1;
+								break;
 							}
 						}
 					}
-					else
+				}
+				else
+				{
+					if ( (V[3][iterator_virtual] != CRITICAL_SERVICES) && (genes[iterator_virtual]-1 == physical_position) )
 					{
-						if ( (V[iterator_virtual][3] != CRITICAL_SERVICES) && (population[iterator_individual][iterator_virtual]-1 == physical_position) )
-						{
-							for (physical_position2 = 0 ; physical_position2 < global_h_sizes[iterator_individual] ; physical_position2++)
-							{	
-								if (physical_position2 != physical_position && cm[iterator_individual][physical_position2] == cl_nc )
-								{
-									available_cpus = (float) H[physical_position2][0] * cm[iterator_individual][physical_position2];
-									available_memory = (float) H[physical_position2][1] * cm[iterator_individual][physical_position2];
-
-									/* If the use of the VM not exceeds the capacity of the physical machine performs the migration */
-									if ( (float) utilization[iterator_individual][physical_position2][0] + (float) V[iterator_virtual][0] <= available_cpus && 
-										 (float) utilization[iterator_individual][physical_position2][1] + (float) V[iterator_virtual][1] <= available_memory && 
-										 (float) utilization[iterator_individual][physical_position2][2] + (float) V[iterator_virtual][2] <= (float) H[physical_position2][2])
-									{
-										/* refresh the utilization */
-										utilization[iterator_individual][physical_position][0] -= V[iterator_virtual][0];
-										utilization[iterator_individual][physical_position][1] -= V[iterator_virtual][1];
-										utilization[iterator_individual][physical_position][2] -= V[iterator_virtual][2];
-
-										utilization[iterator_individual][physical_position2][0] += V[iterator_virtual][0];
-										utilization[iterator_individual][physical_position2][1] += V[iterator_virtual][1];
-										utilization[iterator_individual][physical_position2][2] += V[iterator_virtual][2];
-										
-										/* refresh the population */
-										population[iterator_individual][iterator_virtual] = physical_position2+1;
+						for (physical_position2 = 0 ; physical_position2 < h_sizes[individual] ; physical_position2++)
+						{	
+							if (physical_position2 != physical_position && cm[individual][physical_position2] == context->cl_nc )
+							{
+								available_cpus = (float) H[0][physical_position2] * cm[individual][physical_position2];
+								available_memory = (float) H[1][physical_position2] * cm[individual][physical_position2];
 
-										/* updte the commitment matrix */
-										update_commitment_line (population, cm, V, iterator_individual, h_size, v_size, CRITICAL_SERVICES);
+								/* If the use of the VM not exceeds the capacity of the physical machine performs the migration */
+								if ( (float) UTILIZATION(population, individual, physical_position2)[0] + (float) V[0][iterator_virtual] <= available_cpus && 
+									 (float) UTILIZATION(population, individual, physical_position2)[1] + (float) V[1][iterator_virtual] <= available_memory && 
+									 (float) UTILIZATION(population, individual, physical_position2)[2] + (float) V[2][iterator_virtual] <= (float) H[2][physical_position2])
+								{
+									/* refresh the utilization, the population and the commitment matrix */
+									move_virtual_machine(context, population, cm, H, V, individual, iterator_virtual, physical_position2+1, CRITICAL_SERVICES);
 
-										allocated_vm = 1;
-										break;
-									}
+									allocated_vm = 1;
+									break;
 								}
 							}
 						}
 					}
 				}
 			}
-			/* if was allocated, stay in the same PM to migrate all VMs */
-			if (allocated_vm)
-				physical_position--;
 		}
+		/* if was allocated, stay in the same PM to migrate all VMs */
+		if (allocated_vm)
+			physical_position--;
 	}
 }
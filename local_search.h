@@ -17,10 +17,9 @@
 #include <math.h>
 #include <time.h>
 
-extern float cl_cs;
-extern float cl_nc;
-
-extern int *global_h_sizes;
+#include "population.h"
+#include "context.h"
 
 /* function headers definitions */
-void local_search(int **population, int ***utilization, float **cm, int **H, int **V, int number_of_individuals, int h_size, int v_size, int CRITICAL_SERVICES);
+void local_search(struct vmpos_context *context, struct population *population, float **cm, int **H, int **V, int *h_sizes, int number_of_individuals, int h_size, int v_size, int CRITICAL_SERVICES);
+void local_search_individual(struct vmpos_context *context, struct population *population, float **cm, int **H, int **V, int *h_sizes, int h_size, int v_size, int CRITICAL_SERVICES, int individual);
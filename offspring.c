@@ -0,0 +1,123 @@
+/*
+ * offspring.c: Virtual Machine Placement with OverSubscription Problem - Offspring Pipeline
+ * Date: 17-10-2026
+ *
+ * The stages change only the state of their own individual: its genes, utilization, row of
+ * the commitment matrix, partial sums, lists of virtual machines and h_sizes entry,
+ * so the tasks of different individuals do not need locks.
+*/
+
+/* include offspring pipeline header */
+#include "offspring.h"
+#include "variation.h"
+#include "reparation.h"
+#include "local_search.h"
+#include "evaluation.h"
+
+/* data shared by the tasks of the pipeline */
+struct offspring_data
+{
+	struct vmpos_context *context;
+	struct population *population;
+	float **cm;
+	int **H;
+	int **V;
+	int *h_sizes;
+	int h_size;
+	int repair_h_size;
+	int v_size;
+	int CRITICAL_SERVICES;
+	struct rng *streams;
+	float **objectives_functions;
+};
+
+/* offspring_task: mutation, repair, local search and evaluation of one individual, a task of the thread pool
+ * parameter: data of the pipeline
+ * parameter: identificator of the individual
+ * parameter: worker that runs the task
+ * returns: nothing, it's void
+*/
+static void offspring_task(void *data, int individual, int worker)
+{
+	struct offspring_data *pipeline = (struct offspring_data *) data;
+
+	PROFILE_START(timer);
+	mutate_individual(pipeline->context, pipeline->population, pipeline->cm, pipeline->H, pipeline->V, pipeline->h_sizes, pipeline->v_size, pipeline->CRITICAL_SERVICES, individual, &pipeline->streams[individual]);
+	PROFILE_LAP(pipeline->context, PROFILE_MUTATION, timer);
+
+	if (!is_factible(pipeline->population, pipeline->cm, pipeline->H, pipeline->V, pipeline->repair_h_size, pipeline->v_size, pipeline->CRITICAL_SERVICES, individual))
+		repair_individual(pipeline->context, pipeline->population, pipeline->cm, pipeline->H, pipeline->V, pipeline->h_sizes, pipeline->repair_h_size, pipeline->v_size, pipeline->CRITICAL_SERVICES, individual, &pipeline->streams[individual]);
+	PROFILE_LAP(pipeline->context, PROFILE_REPARATION, timer);
+
+	local_search_individual(pipeline->context, pipeline->population, pipeline->cm, pipeline->H, pipeline->V, pipeline->h_sizes, pipeline->h_size, pipeline->v_size, pipeline->CRITICAL_SERVICES, individual);
+	PROFILE_LAP(pipeline->context, PROFILE_LOCAL_SEARCH, timer);
+
+	evaluation_objectives(pipeline->context, pipeline->population, individual, pipeline->v_size, pipeline->objectives_functions[individual]);
+	PROFILE_LAP(pipeline->context, PROFILE_OBJECTIVES, timer);
+}
+
+/* load_streams: splits a random number stream for each individual, in order
+ * parameter: random number stream that gives the seeds
+ * parameter: number of individuals
+ * parameter: arena to take the streams from, or NULL to use malloc
+ * returns: array of streams
+*/
+struct rng *load_streams(struct rng *rng, int number_of_individuals, struct arena *arena)
+{
+	int iterator_individual;
+	struct rng *streams = (struct rng *) arena_alloc (arena, number_of_individuals * sizeof (struct rng));
+
+	for (iterator_individual = 0; iterator_individual < number_of_individuals; iterator_individual++)
+		rng_split(rng, &streams[iterator_individual]);
+
+	return streams;
+}
+
+/* offspring: mutation, repair, local search and evaluation of the individuals of a population, in parallel
+ * parameter: solver context
+ * parameter: thread pool, or NULL to process the individuals in the calling thread
+ * parameter: population, with its utilization and evaluation loaded
+ * parameter: commitment matrix
+ * parameter: physical machines matrix
+ * parameter: virtual machines matrix
+ * parameter: number of physical machines usable by each individual
+ * parameter: number of individuals
+ * parameter: number of physical machines
+ * parameter: number of physical machines verified by the repair
+ * parameter: number of virtual machines
+ * parameter: random number stream that gives the streams of the individuals
+ * parameter: arena to take the streams and the cost matrix from
+ * returns: cost of each objetive matrix, with all the rows in one block
+*/
+float **offspring(struct vmpos_context *context, struct thread_pool *pool, struct population *population, float **cm, int **H, int **V, int *h_sizes, int number_of_individuals, int h_size, int repair_h_size, int v_size, int CRITICAL_SERVICES, struct rng *rng, struct arena *arena)
+{
+	int iterator_individual;
+	struct offspring_data pipeline;
+
+	float **objectives_functions = (float **) arena_alloc (arena, number_of_individuals * sizeof (float *));
+	float *objectives_functions_data = (float *) arena_alloc (arena, ((size_t) number_of_individuals * 3 + 1) * sizeof (float));
+
+	for (iterator_individual = 0; iterator_individual < number_of_individuals; iterator_individual++)
+		objectives_functions[iterator_individual] = objectives_functions_data + (size_t) iterator_individual * 3;
+
+	pipeline.context = context;
+	pipeline.population = population;
+	pipeline.cm = cm;
+	pipeline.H = H;
+	pipeline.V = V;
+	pipeline.h_sizes = h_sizes;
+	pipeline.h_size = h_size;
+	pipeline.repair_h_size = repair_h_size;
+	pipeline.v_size = v_size;
+	pipeline.CRITICAL_SERVICES = CRITICAL_SERVICES;
+	pipeline.streams = load_streams(rng, number_of_individuals, arena);
+	pipeline.objectives_functions = objectives_functions;
+
+	if (pool != NULL)
+		thread_pool_run(pool, number_of_individuals, offspring_task, &pipeline);
+	else
+		for (iterator_individual = 0; iterator_individual < number_of_individuals; iterator_individual++)
+			offspring_task(&pipeline, iterator_individual, 0);
+
+	return objectives_functions;
+}
@@ -0,0 +1,25 @@
+/*
+ * offspring.h: Virtual Machine Placement with OverSubscription Problem - Offspring Pipeline Header
+ * Date: 17-10-2026
+ *
+ * After the crossover, every individual of Q goes through the mutation, the repair, the local
+ * search and the evaluation of its objective functions without reading the other individuals.
+ * The pipeline runs the four stages for each individual as one task of the thread pool. Each
+ * individual has its own random number stream, split in order from the main stream before the
+ * tasks start, so the results of a run do not depend on the number of threads or on which
+ * thread takes an individual.
+*/
+
+#ifndef OFFSPRING_H
+#define OFFSPRING_H
+
+#include "population.h"
+#include "thread_pool.h"
+#include "rng.h"
+#include "context.h"
+
+/* function headers definitions */
+struct rng *load_streams(struct rng *rng, int number_of_individuals, struct arena *arena);
+float **offspring(struct vmpos_context *context, struct thread_pool *pool, struct population *population, float **cm, int **H, int **V, int *h_sizes, int number_of_individuals, int h_size, int repair_h_size, int v_size, int CRITICAL_SERVICES, struct rng *rng, struct arena *arena);
+
+#endif
@@ -22,319 +22,612 @@
 #include "pareto.h"
 #include "common.h"
 #include "variation.h"
+#include "dominance.h"
 
-/* structure of an element */
-struct pareto_element
+/* sentinel of the removed slots of the hash table */
+static int removed_slot;
+
+/* hash_solution: FNV-1a hash of a placement
+ * parameter: placement
+ * parameter: number of virtual machines
+ * returns: hash of the placement
+*/
+static uint64_t hash_solution(int *solution, int v_size)
 {
-	int *solution;
-	float *costs;
-	struct pareto_element *prev;
-	struct pareto_element *next;
-};
+	uint64_t hash = 14695981039346656037ULL;
+	int iterator_virtual;
 
-struct pareto_element * pareto_create(int v_size, int *individual, float *objectives_functions)
+	for (iterator_virtual = 0; iterator_virtual < v_size; iterator_virtual++)
+	{
+		hash ^= (uint32_t) solution[iterator_virtual];
+		hash *= 1099511628211ULL;
+	}
+	return hash;
+}
+
+/* find_slot: searches a placement in the hash table of the archive
+ * parameter: archive
+ * parameter: placement
+ * parameter: hash of the placement
+ * returns: slot of the placement, or the free slot where it goes if it is not in the archive
+*/
+static struct pareto_slot *find_slot(struct pareto_archive *archive, int *solution, uint64_t hash)
 {
-	struct pareto_element *pareto_current = (struct pareto_element *) malloc (sizeof(struct pareto_element));
-	pareto_current->solution = (int *) malloc (v_size *sizeof(int));
-	pareto_current->costs = (float *) malloc (3 *sizeof(float));
-	pareto_current->solution = individual;
-	pareto_current->costs = objectives_functions;
-	pareto_current->prev = NULL;
-	pareto_current->next = NULL;
-	return pareto_current;
+	size_t mask = (size_t) archive->table_size - 1;
+	size_t index = (size_t) hash & mask;
+	struct pareto_slot *free_slot = NULL;
+
+	while (archive->table[index].solution != NULL)
+	{
+		if (archive->table[index].solution == &removed_slot)
+		{
+			if (free_slot == NULL)
+				free_slot = &archive->table[index];
+		}
+		else if (archive->table[index].hash == hash && !is_different(archive->table[index].solution, solution, archive->v_size))
+			return &archive->table[index];
+
+		index = (index + 1) & mask;
+	}
+	return free_slot != NULL ? free_slot : &archive->table[index];
 }
 
-struct pareto_element * pareto_insert(struct pareto_element *pareto_head, int v_size, int *individual, float *objectives_functions)
+/* resize_table: rebuilds the hash table of the archive without the removed slots, doubling it if it is half used
+ * parameter: archive
+ * returns: nothing, it's void
+*/
+static void resize_table(struct pareto_archive *archive)
 {
-	struct pareto_element *pareto_current = pareto_create(v_size, individual, objectives_functions);
-	struct pareto_element *ptr1;
-	ptr1 = pareto_head;
+	int iterator_element;
+	struct pareto_slot *slot;
 
-	int iterator_virtual;
-	int duplicate = 1;
+	while (archive->table_size < 4 * (archive->size + 1))
+		archive->table_size *= 2;
 
-	if (pareto_head == NULL)
+	free(archive->table);
+	archive->table = (struct pareto_slot *) calloc (archive->table_size, sizeof (struct pareto_slot));
+	if (archive->table == NULL)
 	{
-	  pareto_head = pareto_current;
-		return pareto_head;
+		printf ("[ERROR]: Problem with memory space. Function calloc returned NULL!\n");
+		exit (EXIT_FAILURE);
 	}
-	else
-	{	
-		duplicate = 1;
-		/* is it duplicate? */
-		while(ptr1 != NULL)
-		{
-			for (iterator_virtual = 0 ; iterator_virtual < v_size ; iterator_virtual++)
-			{
-		   	if(ptr1->solution[iterator_virtual] != pareto_current->solution[iterator_virtual])
-		   	{
-					duplicate = 0;
-					break;
-				}
-			}
-			if(duplicate == 1)
-			{
-				return pareto_head;
-			}
-			duplicate = 1;
-			ptr1 = ptr1->next;
-		}
-		/* is it NOT duplicate */
-		pareto_head->prev = pareto_current;
-		pareto_current->next = pareto_head;
-		pareto_head = pareto_current;
-		return pareto_head;
+	archive->table_used = archive->size;
+
+	for (iterator_element = 0; iterator_element < archive->size; iterator_element++)
+	{
+		slot = find_slot(archive, archive->elements[iterator_element].solution, archive->elements[iterator_element].hash);
+		slot->hash = archive->elements[iterator_element].hash;
+		slot->solution = archive->elements[iterator_element].solution;
 	}
 }
 
-/* reference: http://www.geeksforgeeks.org/remove-duplicates-from-an-unsorted-linked-list/ */
-void pareto_remove_duplicates(struct pareto_element *pareto_head, int v_size)
+/* pareto_memory: reserves memory for the archive, finishing the execution if there is no memory
+ * parameter: memory to resize, or NULL
+ * parameter: size in bytes
+ * returns: pointer to the memory
+*/
+static void *pareto_memory(void *memory, size_t size)
 {
-	struct pareto_element *ptr1, *ptr2, *dup;
-	ptr1 = pareto_head;
-	int iterator_virtual;
-	int duplicate = 1;
-	/* Pick elements one by one */
-	while(ptr1 != NULL && ptr1->next != NULL)
+	memory = realloc (memory, size > 0 ? size : 1);
+	if (memory == NULL)
 	{
-		ptr2 = ptr1;
-		/* Compare the picked element with rest of the elements */
-    while(ptr2->next != NULL)
-    {
-			for (iterator_virtual = 0 ; iterator_virtual < v_size ; iterator_virtual++)
-			{
-				if(ptr1->solution[iterator_virtual] != ptr2->next->solution[iterator_virtual])
-				{
-					duplicate = 0;
-					ptr2 = ptr2->next;
-					break;
-				}
-			}
-			if(duplicate == 1)
-			{
-				dup = ptr2->next;
-				ptr2->next = ptr2->next->next;
-				free(dup);
-			}
-			duplicate = 1;
-		}
-		ptr1 = ptr1->next;
+		printf ("[ERROR]: Problem with memory space. Function realloc returned NULL!\n");
+		exit (EXIT_FAILURE);
 	}
+	return memory;
 }
 
-/* get_min_cost: calculate the min value of an objective function in a population
- * parameter: array of the values of the objective functions
- * parameter: objective functions id for evaluation
- * parameter: number of individuals
- * parameter: non-dominated sorting fronts
- * returns: min cost of the identified objetive function
+/* remove_elements: removes elements from the archive, keeping the energy order of the others
+ * parameter: archive
+ * parameter: array with a value different of 0 for each element to remove
+ * returns: nothing, it's void
 */
-float get_min_cost(struct pareto_element *pareto_head, int objective)
+static void remove_elements(struct pareto_archive *archive, signed char *remove)
 {
-	float min_cost = BIG_COST;
-	struct pareto_element *ptr1;
-	ptr1 = pareto_head;
-	/* Pick elements one by one */
-	while(ptr1 != NULL)
+	int iterator_element, kept = 0;
+	struct pareto_element *element;
+
+	for (iterator_element = 0; iterator_element < archive->size; iterator_element++)
 	{
-		if(ptr1->costs[objective] < min_cost)
+		element = &archive->elements[iterator_element];
+
+		if (remove[iterator_element])
 		{
-			min_cost = ptr1->costs[objective];
+			/* the normalizers and the best element are searched again only if they leave */
+			if (element->costs[0] == archive->max_costs[0] || element->costs[1] == archive->max_costs[1] || element->costs[2] == archive->max_costs[2])
+				archive->max_costs_outdated = 1;
+			if (iterator_element == archive->best_element)
+				archive->best_element = -1;
+
+			find_slot(archive, element->solution, element->hash)->solution = &removed_slot;
+			free(element->solution);
+			continue;
 		}
-		ptr1 = ptr1->next;
+
+		if (iterator_element == archive->best_element)
+			archive->best_element = kept;
+
+		archive->elements[kept] = *element;
+		archive->energy[kept] = archive->energy[iterator_element];
+		archive->dispersion[kept] = archive->dispersion[iterator_element];
+		archive->migration[kept] = archive->migration[iterator_element];
+		kept++;
 	}
-	return min_cost;
+	archive->size = kept;
 }
 
-/* get_max_cost: calculate the max value of an objective function in a population
- * parameter: array of the values of the objective functions
- * parameter: objective functions id for evaluation
- * parameter: number of individuals
- * parameter: non-dominated sorting fronts
- * returns: max cost of the identified objetive function
+/* weighted_cost: weighted sum of the objective functions of a solution, each one divided by its max cost in the archive
+ * parameter: archive
+ * parameter: cost of each objective function of the solution
+ * returns: weighted cost of the solution
 */
-float get_max_cost(struct pareto_element *pareto_head, int objective)
+static float weighted_cost(struct pareto_archive *archive, float *costs)
 {
-	float max_cost = -1.0;
-	struct pareto_element *ptr1;
-	ptr1 = pareto_head;
-	/* Pick elements one by one */
-	while(ptr1 != NULL)
+	if (archive->max_costs[2] != 0)
+		return archive->weights[0]*(costs[0]/archive->max_costs[0]) + archive->weights[1]*(costs[1]/archive->max_costs[1]) + 
+				archive->weights[2]*(costs[2]/archive->max_costs[2]);
+	else
+		return archive->weights[0]*(costs[0]/archive->max_costs[0]) + archive->weights[1]*(costs[1]/archive->max_costs[1]) + 
+				archive->weights[2]*(costs[2]);
+}
+
+/* update_best_element: searches again the max costs and the best element of the archive, only if they are outdated
+ * parameter: archive
+ * returns: nothing, it's void
+*/
+static void update_best_element(struct pareto_archive *archive)
+{
+	int iterator_element, iterator_objective;
+	float actual_cost;
+
+	if (archive->max_costs_outdated)
 	{
-		if(ptr1->costs[objective] > max_cost)
+		for (iterator_objective = 0; iterator_objective < 3; iterator_objective++)
 		{
-			max_cost = ptr1->costs[objective];
+			archive->max_costs[iterator_objective] = 0.0;
+			for (iterator_element = 0; iterator_element < archive->size; iterator_element++)
+				if (archive->max_costs[iterator_objective] < archive->elements[iterator_element].costs[iterator_objective])
+					archive->max_costs[iterator_objective] = archive->elements[iterator_element].costs[iterator_objective];
 		}
-		ptr1 = ptr1->next;
+		archive->max_costs_outdated = 0;
+		archive->best_element = -1;
 	}
-	return max_cost;
-}
 
-void print_pareto_set(struct pareto_element *pareto_head, int v_size)
-{
-	int iterator_virtual;
-	while (pareto_head != NULL)
+	if (archive->best_element != -1 || archive->size == 0)
+		return;
+
+	/* the first element with the lowest weighted cost */
+	archive->best_element = 0;
+	archive->best_cost = weighted_cost(archive, archive->elements[0].costs);
+
+	for (iterator_element = 1; iterator_element < archive->size; iterator_element++)
 	{
-		/* iterate on columns */
-		for (iterator_virtual = 0; iterator_virtual < v_size; iterator_virtual++)
+		actual_cost = weighted_cost(archive, archive->elements[iterator_element].costs);
+		if (archive->best_cost > actual_cost)
 		{
-			printf("%d\t",pareto_head->solution[iterator_virtual]);	
+			archive->best_cost = actual_cost;
+			archive->best_element = iterator_element;
 		}
-		printf("\n");
-		pareto_head = pareto_head->next;
 	}
 }
 
-void print_pareto_front(struct pareto_element *pareto_head, int v_size)
+/* box of an element of the archive in the epsilon grid */
+struct pareto_box
+{
+	float box[3];
+	/* distance of the element to the lower corner of its box */
+	float distance;
+	int element;
+};
+
+/* compare_boxes: order of the boxes, and of the distance inside a box, qsort comparator
+ * parameter: boxes to compare
+ * returns: negative, 0 or positive
+*/
+static int compare_boxes(const void *a, const void *b)
+{
+	const struct pareto_box *box_a = (const struct pareto_box *) a;
+	const struct pareto_box *box_b = (const struct pareto_box *) b;
+	int iterator_objective;
+
+	for (iterator_objective = 0; iterator_objective < 3; iterator_objective++)
+		if (box_a->box[iterator_objective] != box_b->box[iterator_objective])
+			return box_a->box[iterator_objective] < box_b->box[iterator_objective] ? -1 : 1;
+
+	if (box_a->distance != box_b->distance)
+		return box_a->distance < box_b->distance ? -1 : 1;
+
+	return box_a->element - box_b->element;
+}
+
+/* thin_archive: keeps one element per epsilon box, in the boxes not dominated by other boxes.
+ * The boxes divide the range of each objective function in the archive in grid parts
+ * parameter: archive
+ * parameter: boxes per objective function
+ * returns: nothing, it's void
+*/
+static void thin_archive(struct pareto_archive *archive, int grid)
 {
-	while (pareto_head != NULL)
+	int iterator_element, iterator_objective;
+	float minimum[3], maximum[3], position;
+	float *costs;
+
+	struct pareto_box *boxes = (struct pareto_box *) pareto_memory (NULL, archive->size * sizeof (struct pareto_box));
+	float **box_rows = (float **) pareto_memory (NULL, archive->size * sizeof (float *));
+	signed char *remove = (signed char *) pareto_memory (NULL, archive->size);
+	int *fronts;
+
+	for (iterator_objective = 0; iterator_objective < 3; iterator_objective++)
 	{
-		print_int_array_line (pareto_head->solution, v_size);
+		minimum[iterator_objective] = get_min_cost(archive, iterator_objective);
+		maximum[iterator_objective] = get_max_cost(archive, iterator_objective);
+		if (!(maximum[iterator_objective] > minimum[iterator_objective]))
+			maximum[iterator_objective] = minimum[iterator_objective] + 1.0;
+	}
 
-		printf("E: %g, D: %g, M: %g\n",pareto_head->costs[0],pareto_head->costs[1],pareto_head->costs[2]);	
-		printf("\n");
-		pareto_head = pareto_head->next;
+	for (iterator_element = 0; iterator_element < archive->size; iterator_element++)
+	{
+		costs = archive->elements[iterator_element].costs;
+		boxes[iterator_element].element = iterator_element;
+		boxes[iterator_element].distance = 0.0;
+
+		for (iterator_objective = 0; iterator_objective < 3; iterator_objective++)
+		{
+			position = (costs[iterator_objective] - minimum[iterator_objective]) / (maximum[iterator_objective] - minimum[iterator_objective]) * grid;
+			/* NaN goes to the last box */
+			if (!(position >= 0.0))
+				position = (float) grid;
+			boxes[iterator_element].box[iterator_objective] = floorf(position);
+			boxes[iterator_element].distance += position - floorf(position);
+		}
+
+		box_rows[iterator_element] = boxes[iterator_element].box;
+		remove[iterator_element] = 0;
 	}
+
+	/* the elements of dominated boxes leave the archive */
+	fronts = non_dominated_sorting(box_rows, archive->size, NULL);
+
+	for (iterator_element = 0; iterator_element < archive->size; iterator_element++)
+		if (fronts[iterator_element] != 1)
+			remove[iterator_element] = 1;
+
+	/* in each box only the element nearest to the corner stays */
+	qsort(boxes, archive->size, sizeof (struct pareto_box), compare_boxes);
+
+	for (iterator_element = 1; iterator_element < archive->size; iterator_element++)
+		if (memcmp(boxes[iterator_element].box, boxes[iterator_element - 1].box, 3 * sizeof (float)) == 0)
+			remove[boxes[iterator_element].element] = 1;
+
+	remove_elements(archive, remove);
+
+	free(fronts);
+	free(boxes);
+	free(box_rows);
+	free(remove);
 }
 
-int load_pareto_size(struct pareto_element *pareto_head)
+/* truncate_archive: thins the archive with coarser epsilon boxes until it has at most max_size elements
+ * parameter: archive
+ * returns: nothing, it's void
+*/
+static void truncate_archive(struct pareto_archive *archive)
 {
-	struct pareto_element *ptr1 = pareto_head;
-	int size = 0;
-	while(ptr1 != NULL)
+	int grid = 2 * (int) ceil(sqrt((double) archive->max_size));
+	int iterator_element, kept;
+	signed char *remove;
+
+	while (archive->size > archive->max_size && grid >= PARETO_MINIMUM_GRID)
 	{
-		size++;
-		ptr1 = ptr1->next;
+		thin_archive(archive, grid);
+		grid -= grid / 4 > 1 ? grid / 4 : 1;
+	}
+
+	/* the coarsest grid was not enough: the elements are taken evenly along the energy order */
+	if (archive->size > archive->max_size)
+	{
+		remove = (signed char *) pareto_memory (NULL, archive->size);
+		memset(remove, 1, archive->size);
+		for (kept = 0; kept < archive->max_size; kept++)
+		{
+			iterator_element = (int) ((long) kept * archive->size / archive->max_size);
+			remove[iterator_element] = 0;
+		}
+		remove_elements(archive, remove);
+		free(remove);
 	}
-	return size;
 }
 
-void report_best_population(struct pareto_element *pareto_head, int **H, int **V, int v_size, int h_size)
+/* pareto_create: creates an empty Pareto archive
+ * parameter: solver context, with the weights of the objective functions
+ * parameter: number of virtual machines
+ * parameter: maximum number of elements, 0 for no maximum
+ * returns: archive
+*/
+struct pareto_archive *pareto_create(struct vmpos_context *context, int v_size, int max_size)
 {
-	int pareto_size = load_pareto_size(pareto_head);
-	int **best_P = (int **) malloc (pareto_size *sizeof (int *));
-	float **objective_functions_best_P = (float **) malloc (pareto_size *sizeof (float *));
+	struct pareto_archive *archive = (struct pareto_archive *) pareto_memory (NULL, sizeof (struct pareto_archive));
+
+	archive->v_size = v_size;
+	archive->max_size = max_size;
+	archive->size = 0;
+	archive->capacity = 16;
+	archive->elements = (struct pareto_element *) pareto_memory (NULL, archive->capacity * sizeof (struct pareto_element));
+	archive->energy = (float *) pareto_memory (NULL, archive->capacity * sizeof (float));
+	archive->dispersion = (float *) pareto_memory (NULL, archive->capacity * sizeof (float));
+	archive->migration = (float *) pareto_memory (NULL, archive->capacity * sizeof (float));
+	archive->dominance_results = (signed char *) pareto_memory (NULL, archive->capacity);
+	archive->max_costs[0] = archive->max_costs[1] = archive->max_costs[2] = 0.0;
+	archive->max_costs_outdated = 0;
+	archive->weights[0] = context->energy_objective_weight;
+	archive->weights[1] = context->dispersion_objective_weight;
+	archive->weights[2] = context->migration_objective_weight;
+	archive->best_element = -1;
+	archive->best_cost = 0.0;
+	archive->table_size = 64;
+	archive->table = NULL;
+	resize_table(archive);
+
+	return archive;
+}
 
-	int iterator_individual;
-	int iterator_virtual;
-	int iterator_physical;
+/* pareto_insert: inserts a solution in the archive if it is not repeated and no solution of the archive dominates it.
+ * The solutions of the archive that it dominates are removed
+ * parameter: archive
+ * parameter: placement of the solution, the archive keeps its own copy
+ * parameter: cost of each objective function of the solution
+ * returns: 1 if the solution was inserted and is still in the archive after its truncation, 0 otherwise
+*/
+int pareto_insert(struct pareto_archive *archive, int *individual, float *objectives_functions)
+{
+	uint64_t hash = hash_solution(individual, archive->v_size);
+	struct pareto_slot *slot = find_slot(archive, individual, hash);
+	struct pareto_element *element;
+	int iterator_element, iterator_objective, position, moved;
+	float actual_cost;
+
+	/* is it duplicate? */
+	if (slot->solution != NULL && slot->solution != &removed_slot)
+	{
+		PROFILE_COUNT(PROFILE_ARCHIVE_DUPLICATES);
+		return 0;
+	}
 
-	int best_indice = 0;
+	/* compare with all the archive at once: is it dominated? */
+	dominance_batch(objectives_functions, archive->energy, archive->dispersion, archive->migration, archive->size, archive->dominance_results);
 
-	float max_energy_cost = 0.0;
-	float max_dispersion_cost = 0.0;
-	float max_migration_cost = 0.0;
-	float best_positioning = 0.0;
-	float actual_positioning_value = 0.0;
+	for (iterator_element = 0; iterator_element < archive->size; iterator_element++)
+		if (archive->dominance_results[iterator_element] == -1)
+			return 0;
 
-	struct pareto_element *ptr2 = pareto_head;
+	/* the solutions it dominates leave the archive, the results are 1 only for them */
+	for (iterator_element = 0; iterator_element < archive->size; iterator_element++)
+		archive->dominance_results[iterator_element] = (archive->dominance_results[iterator_element] == 1);
 
-	FILE *pareto_result;
-	FILE *pareto_data;
+	remove_elements(archive, archive->dominance_results);
 
-	/* copying pareto individuals */	
-	for (iterator_individual=0; iterator_individual < pareto_size; iterator_individual++)
+	if (archive->size == archive->capacity)
 	{
-		best_P[iterator_individual] = (int *) malloc (v_size *sizeof (int));
-		objective_functions_best_P[iterator_individual] = (float *) malloc (3 *sizeof (float));
-		best_P[iterator_individual] = pareto_head->solution;
-		objective_functions_best_P[iterator_individual] = pareto_head->costs;
-		pareto_head = pareto_head->next;
+		archive->capacity *= 2;
+		archive->elements = (struct pareto_element *) pareto_memory (archive->elements, archive->capacity * sizeof (struct pareto_element));
+		archive->energy = (float *) pareto_memory (archive->energy, archive->capacity * sizeof (float));
+		archive->dispersion = (float *) pareto_memory (archive->dispersion, archive->capacity * sizeof (float));
+		archive->migration = (float *) pareto_memory (archive->migration, archive->capacity * sizeof (float));
+		archive->dominance_results = (signed char *) pareto_memory (archive->dominance_results, archive->capacity);
 	}
 
-	/* once the best population is on a matrix, non-dominated sorting is performed */
-	int *fronts_best_P = (int *) non_dominated_sorting(objective_functions_best_P, pareto_size);
-	int ***utilization_best_P = load_utilization(best_P, H, V, pareto_size, h_size, v_size);
-
+	/* position after the solutions with lower or equal energy, NaN at the end */
+	position = archive->size;
+	while (position > 0 && !(archive->energy[position - 1] <= objectives_functions[0]) && !isnan(objectives_functions[0]))
+		position--;
+
+	moved = archive->size - position;
+	memmove(archive->elements + position + 1, archive->elements + position, moved * sizeof (struct pareto_element));
+	memmove(archive->energy + position + 1, archive->energy + position, moved * sizeof (float));
+	memmove(archive->dispersion + position + 1, archive->dispersion + position, moved * sizeof (float));
+	memmove(archive->migration + position + 1, archive->migration + position, moved * sizeof (float));
+
+	/* the element keeps its own copy, the populations are overwritten and freed */
+	element = &archive->elements[position];
+	element->solution = (int *) pareto_memory (NULL, archive->v_size * sizeof (int));
+	memcpy(element->solution, individual, archive->v_size * sizeof (int));
+	memcpy(element->costs, objectives_functions, 3 * sizeof (float));
+	element->hash = hash;
+	archive->energy[position] = objectives_functions[0];
+	archive->dispersion[position] = objectives_functions[1];
+	archive->migration[position] = objectives_functions[2];
+	archive->size++;
+
+	if (archive->best_element >= position)
+		archive->best_element++;
+
+	/* a new max cost changes the weighted cost of all the archive, otherwise only the new solution is compared with the best */
+	for (iterator_objective = 0; iterator_objective < 3; iterator_objective++)
+	{
+		if (archive->max_costs[iterator_objective] < objectives_functions[iterator_objective])
+		{
+			archive->max_costs[iterator_objective] = objectives_functions[iterator_objective];
+			archive->best_element = -1;
+		}
+	}
 
-	/* save the Pareto set and the Pareto front  */
-	/* for each individual */
-	for (iterator_individual=0; iterator_individual < pareto_size; iterator_individual++)
+	if (archive->best_element != -1)
 	{
-		//* only the first pareto front
-		if(fronts_best_P[iterator_individual]==1)
+		actual_cost = weighted_cost(archive, objectives_functions);
+		if (isnan(actual_cost) || isnan(archive->best_cost))
+			archive->best_element = -1;
+		else if (archive->best_cost > actual_cost || (archive->best_cost == actual_cost && position < archive->best_element))
 		{
-			if (max_energy_cost < objective_functions_best_P[iterator_individual][0])
-				max_energy_cost = objective_functions_best_P[iterator_individual][0];
-			if (max_dispersion_cost < objective_functions_best_P[iterator_individual][1])
-				max_dispersion_cost = objective_functions_best_P[iterator_individual][1];
-			if (max_migration_cost < objective_functions_best_P[iterator_individual][2])
-				max_migration_cost = objective_functions_best_P[iterator_individual][2];
+			archive->best_cost = actual_cost;
+			archive->best_element = position;
 		}
 	}
 
-	/* Initialization to the first individal to compare with others */
-	if(max_migration_cost != 0)
-		best_positioning = energy_objective_weight*(objective_functions_best_P[0][0]/max_energy_cost) + dispersion_objective_weight*(objective_functions_best_P[0][1]/max_dispersion_cost) + 
-										migration_objective_weight*(objective_functions_best_P[0][2]/max_migration_cost);
-	else
-		best_positioning = energy_objective_weight*(objective_functions_best_P[0][0]/max_energy_cost) + dispersion_objective_weight*(objective_functions_best_P[0][1]/max_dispersion_cost) + 
-										migration_objective_weight*(objective_functions_best_P[0][2]);
+	/* the slot can be reused only if it was not moved by the removals, the table is searched again */
+	slot = find_slot(archive, individual, hash);
+	if (slot->solution == NULL)
+		archive->table_used++;
+	slot->hash = hash;
+	slot->solution = element->solution;
+
+	if (2 * archive->table_used > archive->table_size)
+		resize_table(archive);
 
-	for (iterator_individual=0; iterator_individual < pareto_size; iterator_individual++)
+	/* the archive is bounded: it is thinned, and the new solution may not stay */
+	if (archive->max_size > 0 && archive->size > archive->max_size)
 	{
-		//* only the first pareto front
-		if(fronts_best_P[iterator_individual]==1)
+		truncate_archive(archive);
+		slot = find_slot(archive, individual, hash);
+		return slot->solution != NULL && slot->solution != &removed_slot;
+	}
+
+	return 1;
+}
+
+/* get_min_cost: calculate the min value of an objective function in the archive
+ * parameter: archive
+ * parameter: objective functions id for evaluation
+ * returns: min cost of the identified objetive function, INFINITY if the archive is empty. NaN costs are skipped
+*/
+float get_min_cost(struct pareto_archive *archive, int objective)
+{
+	float min_cost = INFINITY;
+	int iterator_element;
+
+	for (iterator_element = 0; iterator_element < archive->size; iterator_element++)
+		if(archive->elements[iterator_element].costs[objective] < min_cost)
+			min_cost = archive->elements[iterator_element].costs[objective];
+
+	return min_cost;
+}
+
+/* get_max_cost: calculate the max value of an objective function in the archive
+ * parameter: archive
+ * parameter: objective functions id for evaluation
+ * returns: max cost of the identified objetive function, -INFINITY if the archive is empty. NaN costs are skipped
+*/
+float get_max_cost(struct pareto_archive *archive, int objective)
+{
+	float max_cost = -INFINITY;
+	int iterator_element;
+
+	for (iterator_element = 0; iterator_element < archive->size; iterator_element++)
+		if(archive->elements[iterator_element].costs[objective] > max_cost)
+			max_cost = archive->elements[iterator_element].costs[objective];
+
+	return max_cost;
+}
+
+void print_pareto_set(struct pareto_archive *archive)
+{
+	int iterator_virtual;
+	int iterator_element;
+
+	for (iterator_element = 0; iterator_element < archive->size; iterator_element++)
+	{
+		/* iterate on columns */
+		for (iterator_virtual = 0; iterator_virtual < archive->v_size; iterator_virtual++)
 		{
-			if(max_migration_cost != 0)			
-				actual_positioning_value = energy_objective_weight*(objective_functions_best_P[iterator_individual][0]/max_energy_cost) + 
-											dispersion_objective_weight*(objective_functions_best_P[iterator_individual][1]/max_dispersion_cost) + 
-											migration_objective_weight*(objective_functions_best_P[iterator_individual][2]/max_migration_cost);
-			else
-				actual_positioning_value = energy_objective_weight*(objective_functions_best_P[iterator_individual][0]/max_energy_cost) + 
-											dispersion_objective_weight*(objective_functions_best_P[iterator_individual][1]/max_dispersion_cost) + 
-											migration_objective_weight*(objective_functions_best_P[iterator_individual][2]);
-
-			if (best_positioning > actual_positioning_value )
-			{
-				best_positioning = actual_positioning_value;
-				best_indice = iterator_individual;
-			}
+			printf("%d\t",archive->elements[iterator_element].solution[iterator_virtual]);
 		}
+		printf("\n");
 	}
+}
+
+void print_pareto_front(struct pareto_archive *archive)
+{
+	int iterator_element;
+	struct pareto_element *element;
 
-	if ( best_positioning < global_best_individual_cost && is_different (best_P[best_indice ], global_best_individual, v_size))
+	for (iterator_element = 0; iterator_element < archive->size; iterator_element++)
 	{
-		pareto_result = fopen("results/pareto_result","a");
+		element = &archive->elements[iterator_element];
+		print_int_array_line (element->solution, archive->v_size);
+
+		printf("E: %g, D: %g, M: %g\n",element->costs[0],element->costs[1],element->costs[2]);
+		printf("\n");
+	}
+}
+
+int load_pareto_size(struct pareto_archive *archive)
+{
+	return archive->size;
+}
+
+/* report_best_population: reports the element of the archive with the lowest weighted cost if it is better than the global best.
+ * The max costs and the best element are kept by the archive, so only what changed since the last report is evaluated
+ * parameter: solver context
+ * parameter: archive
+ * parameter: number of virtual machines
+ * parameter: number of physical machines
+ * returns: nothing, it's void
+*/
+void report_best_population(struct vmpos_context *context, struct pareto_archive *archive, int v_size, int h_size)
+{
+	int iterator_virtual;
+	int best_indice;
+	float best_positioning;
+	int *best_solution;
+	float *best_costs;
+
+	FILE *pareto_result;
+	FILE *pareto_data;
 
-		fprintf(pareto_result,"\n *** GENERATION = %d ***", generation);
+	update_best_element(archive);
 
-		best_generation = generation;
-		global_best_individual_cost = best_positioning;
-		generations_without_improvment = 0;
+	if (archive->best_element == -1)
+	{
+		context->generations_without_improvment++;
+		return;
+	}
 
-		fprintf(pareto_result,"\n=========================================================\n");
-		fprintf(pareto_result,"\t\tTHE BEST POSITIONING IS:\n");
+	best_indice = archive->best_element;
+	best_positioning = archive->best_cost;
+	best_solution = archive->elements[best_indice].solution;
+	best_costs = archive->elements[best_indice].costs;
+
+	if ( best_positioning < context->global_best_individual_cost && is_different (best_solution, context->global_best_individual, v_size))
+	{
+		context->best_generation = context->generation;
+		context->global_best_individual_cost = best_positioning;
+		context->generations_without_improvment = 0;
 
 		// Copy the best individual found to global_best_individual
 		for (iterator_virtual = 0; iterator_virtual < v_size; iterator_virtual++)
+			context->global_best_individual[iterator_virtual] = best_solution[iterator_virtual];
+
+		context->global_best_objective_functions[0] = best_costs[0];
+		context->global_best_objective_functions[1] = best_costs[1];
+		context->global_best_objective_functions[2] = best_costs[2];
+
+		int pm_used_in_best = update_pm_used_in_individual (context, best_indice, h_size, v_size);
+
+		/* the report is written only if the context has a results directory */
+		if ( (pareto_result = open_result_file(context, "pareto_result")) != NULL )
 		{
-			global_best_individual[iterator_virtual] = best_P[best_indice][iterator_virtual];
-			fprintf(pareto_result,"%d ", global_best_individual[iterator_virtual]);
-		}
+			fprintf(pareto_result,"\n *** GENERATION = %d ***", context->generation);
+			fprintf(pareto_result,"\n=========================================================\n");
+			fprintf(pareto_result,"\t\tTHE BEST POSITIONING IS:\n");
 
-		global_best_objective_functions[0] = objective_functions_best_P[best_indice][0];
-		global_best_objective_functions[1] = objective_functions_best_P[best_indice][1];
-		global_best_objective_functions[2] = objective_functions_best_P[best_indice][2];
+			for (iterator_virtual = 0; iterator_virtual < v_size; iterator_virtual++)
+				fprintf(pareto_result,"%d ", context->global_best_individual[iterator_virtual]);
 
-		update_pm_used_in_individual (best_indice, h_size, v_size);
+			fprintf(pareto_result,"\n");
+			fprintf(pareto_result,"\nCOSTS:\tEnergy Cons.: %g\tDispersion Level.: %g\tMigr.: %g\t", context->global_best_objective_functions[0], context->global_best_objective_functions[1],context->global_best_objective_functions[2]);
+			fprintf(pareto_result,"Allocated in [%d] PM.\n", pm_used_in_best);
+			fprintf(pareto_result,"=========================================================\n\n");
 
-		fprintf(pareto_result,"\n");
-		fprintf(pareto_result,"\nCOSTS:\tEnergy Cons.: %g\tDispersion Level.: %g\tMigr.: %g\t", global_best_objective_functions[0], global_best_objective_functions[1],global_best_objective_functions[2]);
-		fprintf(pareto_result,"Allocated in [%d] PM.\n", global_h_sizes[best_indice]);
-		fprintf(pareto_result,"=========================================================\n\n");
-		
-		fclose(pareto_result);
+			fclose(pareto_result);
+		}
 	}
 	else
 	{
-		generations_without_improvment++;
+		context->generations_without_improvment++;
 	}
 	
-	if (generation == total_of_generations)
+	if (context->generation == context->total_of_generations && (pareto_data = open_result_file(context, "pareto_result_data")) != NULL)
 	{
-		pareto_data = fopen("results/pareto_result_data","a");
-		fprintf(pareto_data,"%g\t%g\t%g\t%f\t%d\t", global_best_objective_functions[0], global_best_objective_functions[1],global_best_objective_functions[2], global_best_individual_cost, best_generation);
+		fprintf(pareto_data,"%g\t%g\t%g\t%f\t%d\t", context->global_best_objective_functions[0], context->global_best_objective_functions[1],context->global_best_objective_functions[2], context->global_best_individual_cost, context->best_generation);
 		fclose(pareto_data);
 	}
 }
@@ -355,20 +648,22 @@ int is_different (int *array1, int *array2, int columns)
 
 
 
-void free_pareto_front(struct pareto_element *pareto_head)
+/* free_pareto_archive: frees the archive and its solutions
+ * parameter: archive
+ * returns: nothing, it's void
+*/
+void free_pareto_archive(struct pareto_archive *archive)
 {
-	struct pareto_element *ptr1, *ptr2;
-	ptr1 = pareto_head;
-
-	int iterator;
-	int pareto_size = load_pareto_size(pareto_head);
-
-	for (iterator = 0 ; iterator < pareto_size ; iterator++)
-	{
-		ptr2 = ptr1->next;
-		free( ptr1 -> solution );
-		free( ptr1 -> costs);
-		ptr1 = ptr2;
-	}
-	free(pareto_head);
+	int iterator_element;
+
+	for (iterator_element = 0; iterator_element < archive->size; iterator_element++)
+		free(archive->elements[iterator_element].solution);
+
+	free(archive->elements);
+	free(archive->energy);
+	free(archive->dispersion);
+	free(archive->migration);
+	free(archive->dominance_results);
+	free(archive->table);
+	free(archive);
 }
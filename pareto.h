@@ -10,28 +10,66 @@
  * Available at: https://github.com/flopezpires
 */
 
+#include <stdint.h>
 
-//* The global variable to control the evolution of the best solution
-extern int generations_without_improvment;
-extern float global_best_individual_cost;
-extern int *global_best_individual;
-extern float *global_best_objective_functions;
-extern int generation;
-extern int best_generation;
+#include "context.h"
 
-extern float energy_objective_weight;
-extern float dispersion_objective_weight;
-extern float migration_objective_weight;
+/* structure of an element: a non-dominated placement and its costs */
+struct pareto_element
+{
+	int *solution;
+	float costs[3];
+	/* hash of the placement */
+	uint64_t hash;
+};
+
+/* slot of the hash table of the placements of the archive */
+struct pareto_slot
+{
+	uint64_t hash;
+	/* placement of an element, NULL if the slot is free */
+	int *solution;
+};
+
+/* structure of the Pareto archive: the non-dominated placements found, without repetitions */
+struct pareto_archive
+{
+	int v_size;
+	/* elements sorted by increasing energy, with their costs also by columns for the dominance kernel */
+	struct pareto_element *elements;
+	float *energy;
+	float *dispersion;
+	float *migration;
+	signed char *dominance_results;
+	int size;
+	int capacity;
+	/* hash table of the placements, open addressing with linear probing. table_used counts the removed slots too */
+	struct pareto_slot *table;
+	int table_size;
+	int table_used;
+	/* maximum number of elements, 0 for no maximum. Beyond it the archive is thinned by epsilon boxes */
+	int max_size;
+	/* max cost of each objective function, the normalizers of the weighted cost. Outdated after the removal of a max */
+	float max_costs[3];
+	int max_costs_outdated;
+	/* weights of the objective functions in the weighted cost */
+	float weights[3];
+	/* element with the lowest weighted cost, -1 if it must be searched again */
+	int best_element;
+	float best_cost;
+};
+
+/* smallest epsilon box grid, in boxes per objective function, before the archive is cut by energy order */
+#define PARETO_MINIMUM_GRID 2
 
 /* include functions */
-struct pareto_element * pareto_create(int v_size, int *individual, float *objectives_functions);
-struct pareto_element * pareto_insert(struct pareto_element *pareto_head, int v_size, int *individual, float *objectives_functions);
-void pareto_remove_duplicates(struct pareto_element *pareto_head, int v_size);
-float get_min_cost(struct pareto_element *pareto_head, int objective);
-float get_max_cost(struct pareto_element *pareto_head, int objective);
-void print_pareto_set(struct pareto_element *pareto_head, int v_size);
-void print_pareto_front(struct pareto_element *pareto_head, int v_size);
-int load_pareto_size(struct pareto_element *pareto_head);
-void report_best_population(struct pareto_element *pareto_head, int **H, int **V, int v_size, int h_size);
+struct pareto_archive *pareto_create(struct vmpos_context *context, int v_size, int max_size);
+int pareto_insert(struct pareto_archive *archive, int *individual, float *objectives_functions);
+float get_min_cost(struct pareto_archive *archive, int objective);
+float get_max_cost(struct pareto_archive *archive, int objective);
+void print_pareto_set(struct pareto_archive *archive);
+void print_pareto_front(struct pareto_archive *archive);
+int load_pareto_size(struct pareto_archive *archive);
+void report_best_population(struct vmpos_context *context, struct pareto_archive *archive, int v_size, int h_size);
 int is_different (int *array1, int *array2, int columns);
-void free_pareto_front(struct pareto_element *pareto_head);
+void free_pareto_archive(struct pareto_archive *archive);
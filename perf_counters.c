@@ -0,0 +1,214 @@
+/*
+ * perf_counters.c: Virtual Machine Placement with OverSubscription Problem - Hardware Counters
+ * Date: 17-10-2026
+ *
+ * The counters of a thread are one group, read with one system call, and its times enabled
+ * and running scale the events when the kernel shares the counters of the processor between
+ * several groups. The group is closed by the destructor of a thread key when the thread ends.
+*/
+
+/* include hardware counters header */
+#include "perf_counters.h"
+
+#ifdef VMPOS_PROFILE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <pthread.h>
+
+#ifdef __linux__
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+/* counters of a thread */
+struct perf_thread
+{
+	/* descriptor of each event, -1 if the processor does not have it. The cycles are the leader of the group */
+	int descriptors[PERF_EVENTS];
+	/* position of each event in the values of a read of the group */
+	int positions[PERF_EVENTS];
+	int size;
+	/* events opened, one bit per event */
+	int available;
+	/* values and times of the group at the last read */
+	unsigned long long last[PERF_EVENTS];
+	unsigned long long last_enabled;
+	unsigned long long last_running;
+};
+
+static _Thread_local struct perf_thread *perf_thread = NULL;
+static _Thread_local int perf_failed = 0;
+static pthread_key_t perf_key;
+static pthread_once_t perf_key_once = PTHREAD_ONCE_INIT;
+
+/* perf_thread_free: closes the counters of a thread when it ends
+ * parameter: counters of the thread
+ * returns: nothing, it's void
+*/
+static void perf_thread_free(void *data)
+{
+	struct perf_thread *thread = (struct perf_thread *) data;
+	int iterator_event;
+
+	for (iterator_event = PERF_EVENTS - 1; iterator_event >= 0; iterator_event--)
+		if (thread->descriptors[iterator_event] >= 0)
+			close(thread->descriptors[iterator_event]);
+
+	free(thread);
+}
+
+/* perf_key_create: creates the thread key that closes the counters
+ * returns: nothing, it's void
+*/
+static void perf_key_create(void)
+{
+	pthread_key_create(&perf_key, perf_thread_free);
+}
+
+/* open_event: opens a counter of the calling thread, in user space
+ * parameter: event, from PERF_CYCLES to PERF_BRANCH_MISSES
+ * parameter: descriptor of the leader of the group, -1 to open the leader
+ * returns: descriptor, -1 if the counter could not be opened
+*/
+static int open_event(int event, int group)
+{
+#ifdef __linux__
+	static const unsigned long long configs[PERF_EVENTS] = {
+		PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES
+	};
+	struct perf_event_attr attributes;
+
+	memset(&attributes, 0, sizeof (struct perf_event_attr));
+	attributes.size = sizeof (struct perf_event_attr);
+	attributes.type = PERF_TYPE_HARDWARE;
+	attributes.config = configs[event];
+	attributes.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+	attributes.exclude_kernel = 1;
+	attributes.exclude_hv = 1;
+
+	return (int) syscall(SYS_perf_event_open, &attributes, 0, -1, group, PERF_FLAG_FD_CLOEXEC);
+#else
+	(void) event;
+	(void) group;
+	errno = ENOSYS;
+
+	return -1;
+#endif
+}
+
+/* perf_counters_open: opens the counters of the calling thread, if they are not open
+ * returns: events opened, one bit per event (1 << PERF_CYCLES, ...), 0 if the cycles could not be opened
+*/
+int perf_counters_open(void)
+{
+	struct perf_thread *thread;
+	int iterator_event;
+
+	if (perf_thread != NULL)
+		return perf_thread->available;
+
+	/* the warning is written once, the thread does not try again */
+	if (perf_failed)
+		return 0;
+
+	thread = (struct perf_thread *) malloc (sizeof (struct perf_thread));
+
+	if (thread == NULL)
+	{
+		printf ("[ERROR]: Problem with memory space. Function malloc returned NULL!\n");
+		exit (EXIT_FAILURE);
+	}
+
+	memset(thread, 0, sizeof (struct perf_thread));
+
+	thread->descriptors[PERF_CYCLES] = open_event(PERF_CYCLES, -1);
+
+	if (thread->descriptors[PERF_CYCLES] < 0)
+	{
+		printf("\n[WARNING]: The hardware counters could not be opened (%s), they will not be read. Check /proc/sys/kernel/perf_event_paranoid.\n", strerror(errno));
+		free(thread);
+		perf_failed = 1;
+		return 0;
+	}
+
+	for (iterator_event = 0; iterator_event < PERF_EVENTS; iterator_event++)
+	{
+		if (iterator_event != PERF_CYCLES)
+			thread->descriptors[iterator_event] = open_event(iterator_event, thread->descriptors[PERF_CYCLES]);
+
+		if (thread->descriptors[iterator_event] >= 0)
+		{
+			thread->positions[iterator_event] = thread->size++;
+			thread->available |= 1 << iterator_event;
+		}
+	}
+
+	pthread_once(&perf_key_once, perf_key_create);
+	pthread_setspecific(perf_key, thread);
+	perf_thread = thread;
+
+	/* the events are counted from now */
+	perf_counters_mark();
+
+	return thread->available;
+}
+
+/* perf_counters_mark: starts the count of the events of the calling thread from now, if it has counters
+ * returns: nothing, it's void
+*/
+void perf_counters_mark(void)
+{
+	unsigned long long events[PERF_EVENTS];
+
+	if (perf_thread != NULL)
+		perf_counters_read(events);
+}
+
+/* perf_counters_read: reads the events of the calling thread since its last read or mark
+ * parameter: events read, 0 for the events the processor does not have
+ * returns: 1 if the events were read, 0 if the thread has no counters
+*/
+int perf_counters_read(unsigned long long events[PERF_EVENTS])
+{
+	struct perf_thread *thread = perf_thread;
+	/* number of events, times enabled and running, and the value of each event */
+	unsigned long long values[3 + PERF_EVENTS];
+	unsigned long long enabled, running, value;
+	int iterator_event;
+
+	if (thread == NULL)
+		return 0;
+
+	if (read(thread->descriptors[PERF_CYCLES], values, sizeof (values)) < (ssize_t) ((3 + thread->size) * sizeof (unsigned long long)))
+		return 0;
+
+	enabled = values[1] - thread->last_enabled;
+	running = values[2] - thread->last_running;
+
+	for (iterator_event = 0; iterator_event < PERF_EVENTS; iterator_event++)
+	{
+		events[iterator_event] = 0;
+
+		if (thread->descriptors[iterator_event] < 0)
+			continue;
+
+		value = values[3 + thread->positions[iterator_event]];
+
+		/* with the counters shared, the events are scaled to the time the group was enabled */
+		if (running > 0)
+			events[iterator_event] = running < enabled ? (unsigned long long) ((double) (value - thread->last[iterator_event]) * enabled / running) : value - thread->last[iterator_event];
+
+		thread->last[iterator_event] = value;
+	}
+
+	thread->last_enabled = values[1];
+	thread->last_running = values[2];
+
+	return 1;
+}
+
+#endif
@@ -0,0 +1,29 @@
+/*
+ * perf_counters.h: Virtual Machine Placement with OverSubscription Problem - Hardware Counters Header
+ * Date: 17-10-2026
+ *
+ * Reads the hardware performance counters of the processor with perf_event_open (Linux): the
+ * cycles, the instructions, the cache misses and the branch misses of the calling thread, in
+ * user space. Each thread opens its group of counters at its first use and keeps it until it
+ * finishes, and each read gives the events since the last read or mark of the same thread, so
+ * the laps of the stage profiler get the events of their stage. The cycles are needed, the
+ * other events are read if the processor has them. It is compiled with the profiler, only with
+ * -DVMPOS_PROFILE, and it is turned on for a solve with the hardware_counters of the context.
+*/
+
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+/* events of the counters */
+#define PERF_CYCLES 0
+#define PERF_INSTRUCTIONS 1
+#define PERF_CACHE_MISSES 2
+#define PERF_BRANCH_MISSES 3
+#define PERF_EVENTS 4
+
+/* function headers definitions */
+int perf_counters_open(void);
+void perf_counters_mark(void);
+int perf_counters_read(unsigned long long events[PERF_EVENTS]);
+
+#endif
@@ -0,0 +1,69 @@
+/*
+ * population.c: Virtual Machine Placement with OverSubscription Problem - Population Storage
+ * Date: 17-10-2026
+ *
+ * The genes of all the individuals of a population are stored in a single block, so a
+ * population costs two allocations whatever its size, plus one for its utilization. A
+ * population can also be taken from an arena, and then it is released with the arena.
+*/
+
+/* include population header */
+#include "population.h"
+
+/* population_create: reserves a population
+ * parameter: number of individuals
+ * parameter: number of virtual machines
+ * parameter: arena to take the population from, or NULL to use malloc
+ * returns: population with all the genes set to 0
+*/
+struct population *population_create(int number_of_individuals, int v_size, struct arena *arena)
+{
+	struct population *population = (struct population *) arena_alloc (arena, sizeof (struct population));
+
+	population->genes = (int *) arena_alloc (arena, ((size_t) number_of_individuals * v_size + 1) * sizeof (int));
+	memset(population->genes, 0, ((size_t) number_of_individuals * v_size + 1) * sizeof (int));
+
+	population->arena = arena;
+	population->utilization = NULL;
+	population->physical_evaluation = NULL;
+	population->evaluation = NULL;
+	population->first_virtual_machine = NULL;
+	population->next_virtual_machine = NULL;
+	population->previous_virtual_machine = NULL;
+	population->number_of_individuals = number_of_individuals;
+	population->h_size = 0;
+	population->v_size = v_size;
+
+	return population;
+}
+
+/* population_copy_individual: copies the genes of an individual to another position
+ * parameter: destination population
+ * parameter: individual of the destination population
+ * parameter: source population
+ * parameter: individual of the source population
+ * returns: nothing, it's void
+*/
+void population_copy_individual(struct population *destination, int destination_individual, struct population *source, int source_individual)
+{
+	memcpy(INDIVIDUAL(destination, destination_individual), INDIVIDUAL(source, source_individual), (size_t) source->v_size * sizeof (int));
+}
+
+/* population_free: frees the memory of a population
+ * parameter: population. A population taken from an arena is released with the arena
+ * returns: nothing, it's void
+*/
+void population_free(struct population *population)
+{
+	if (population == NULL || population->arena != NULL)
+		return;
+
+	free(population->genes);
+	free(population->utilization);
+	free(population->physical_evaluation);
+	free(population->evaluation);
+	free(population->first_virtual_machine);
+	free(population->next_virtual_machine);
+	free(population->previous_virtual_machine);
+	free(population);
+}
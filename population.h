@@ -0,0 +1,90 @@
+/*
+ * population.h: Virtual Machine Placement with OverSubscription Problem - Population Storage Header
+ * Date: 17-10-2026
+ *
+ * A population keeps the placements of all its individuals in one contiguous block of
+ * number_of_individuals x v_size genes, accessed by rows of v_size genes. The utilization
+ * of the physical machines of every individual is kept in another contiguous block of
+ * number_of_individuals x h_size x 3 values (Processor, Memory and Storage). The partial
+ * sums of the objective functions of every individual, kept up to date on each move of a
+ * virtual machine, are kept in two more blocks (see evaluation.h), with an index of the
+ * virtual machines hosted by each physical machine.
+*/
+
+#ifndef POPULATION_H
+#define POPULATION_H
+
+/* include libraries */
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+#include "arena.h"
+
+/* partial sums of the objective functions kept for a physical machine of an individual */
+struct physical_evaluation
+{
+	/* virtual machines hosted, with and without critical services */
+	int critical_vms;
+	int no_critical_vms;
+	/* energy consumption of the physical machine, 0 if it is turned off */
+	double power;
+	/* 1 if the physical machine is counted as a PM with critical / with no critical services in the dispersion level */
+	unsigned char counted_cs;
+	unsigned char counted_ncs;
+};
+
+/* partial sums of the objective functions kept for an individual */
+struct individual_evaluation
+{
+	/* sum of the power of the physical machines */
+	double energy;
+	/* physical machines with critical / with no critical services, for the dispersion level */
+	int pm_cs;
+	int pm_ncs;
+	/* virtual machines with critical / with no critical services placed out of their base solution position */
+	int moved_cs;
+	int moved_ncs;
+};
+
+/* structure of a population */
+struct population
+{
+	/* placements of the individuals, one row of v_size genes per individual */
+	int *genes;
+	/* utilization of the physical machines, [individual][physical][resource]. Reserved by load_utilization */
+	int *utilization;
+	/* partial sums of the objective functions, [individual][physical] and [individual]. Reserved by load_evaluation */
+	struct physical_evaluation *physical_evaluation;
+	struct individual_evaluation *evaluation;
+	/* virtual machines of each position (0 for not placed, then each physical machine), as linked lists in increasing
+	   order: [individual][position] has the first one and [individual][virtual] the next and previous ones, -1 at the ends */
+	int *first_virtual_machine;
+	int *next_virtual_machine;
+	int *previous_virtual_machine;
+	int number_of_individuals;
+	int h_size;
+	int v_size;
+	/* arena that holds the population, NULL if it was reserved with malloc */
+	struct arena *arena;
+};
+
+/* row of genes of an individual of a population */
+#define INDIVIDUAL(population, individual) ((population)->genes + (size_t) (individual) * (population)->v_size)
+/* utilization of Processor, Memory and Storage of a physical machine of an individual */
+#define UTILIZATION(population, individual, physical) ((population)->utilization + ((size_t) (individual) * (population)->h_size + (physical)) * 3)
+
+/* partial sums of a physical machine of an individual */
+#define PHYSICAL_EVALUATION(population, individual, physical) ((population)->physical_evaluation + (size_t) (individual) * (population)->h_size + (physical))
+
+/* first virtual machine of a position (gene value) of an individual, and next virtual machine in the same position */
+#define FIRST_VIRTUAL_MACHINE(population, individual, position) ((population)->first_virtual_machine[(size_t) (individual) * ((population)->h_size + 1) + (position)])
+#define NEXT_VIRTUAL_MACHINE(population, individual, virtual_machine) ((population)->next_virtual_machine[(size_t) (individual) * (population)->v_size + (virtual_machine)])
+#define PREVIOUS_VIRTUAL_MACHINE(population, individual, virtual_machine) ((population)->previous_virtual_machine[(size_t) (individual) * (population)->v_size + (virtual_machine)])
+
+/* function headers definitions */
+struct population *population_create(int number_of_individuals, int v_size, struct arena *arena);
+void population_copy_individual(struct population *destination, int destination_individual, struct population *source, int source_individual);
+void population_free(struct population *population);
+
+#endif
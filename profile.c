@@ -0,0 +1,230 @@
+/*
+ * profile.c: Virtual Machine Placement with OverSubscription Problem - Stage Profiler
+ * Date: 17-10-2026
+ *
+ * The laps of the stages of Q run in the workers of the thread pool at the same time, so the
+ * totals of a profile are added with atomic operations. The breakdown by generation is written
+ * in the results directory of the context, in the file profile_generations.
+*/
+
+/* include stage profiler header */
+#include "profile.h"
+
+#ifdef VMPOS_PROFILE
+
+#include "common.h"
+#include "context.h"
+#include "trace.h"
+
+/* names of the stages and of the counters in the reports */
+static const char *stage_names[PROFILE_STAGES] = {
+	"initialization", "selection and crossover", "load_utilization", "calculates_commitment", "load_evaluation",
+	"mutation", "reparation", "local_search", "load_objectives", "offspring (wall)", "non_dominated_sorting", "pareto_insert",
+	"population_evolution", "island_migration", "report_best_population"
+};
+static const char *counter_names[PROFILE_COUNTERS] = {
+	"VM moves", "commitment updates", "failed repair scans", "archive duplicates"
+};
+
+_Thread_local unsigned long long profile_pending[PROFILE_COUNTERS];
+
+/* nanoseconds: nanoseconds from one moment of the monotonic clock to another
+ * parameter: first moment
+ * parameter: second moment
+ * returns: nanoseconds
+*/
+static unsigned long long nanoseconds(struct timespec *first, struct timespec *second)
+{
+	return (unsigned long long) ((long long) (second->tv_sec - first->tv_sec) * 1000000000LL + (second->tv_nsec - first->tv_nsec));
+}
+
+/* profile_reset: clears the profile of the context at the beginning of a solve and writes the header of the breakdown
+ * parameter: solver context
+ * returns: nothing, it's void
+*/
+void profile_reset(struct vmpos_context *context)
+{
+	struct profile *profile = &context->profile;
+	FILE *breakdown = open_result_file(context, "profile_generations");
+	int iterator_stage, iterator_counter;
+
+	memset(profile, 0, sizeof (struct profile));
+	memset(profile_pending, 0, sizeof (profile_pending));
+	clock_gettime(CLOCK_MONOTONIC, &profile->start);
+	profile->last_generation = profile->start;
+
+	if (context->trace_path != NULL)
+		profile->trace = trace_open(context->trace_path, &profile->start);
+
+	/* the other threads open their counters at their first lap */
+	if (context->hardware_counters)
+		profile->hardware_events = perf_counters_open();
+
+	if (breakdown == NULL)
+		return;
+
+	/* one line per generation: its wall time and the milliseconds of each stage, then the operations counted */
+	fprintf(breakdown, "\ngeneration\twall_ms");
+	for (iterator_stage = 0; iterator_stage < PROFILE_STAGES; iterator_stage++)
+		fprintf(breakdown, "\t%s_ms", stage_names[iterator_stage]);
+	for (iterator_counter = 0; iterator_counter < PROFILE_COUNTERS; iterator_counter++)
+		fprintf(breakdown, "\t%s", counter_names[iterator_counter]);
+	fprintf(breakdown, "\n");
+	fclose(breakdown);
+}
+
+/* profile_lap: adds the time since the timer to a stage, with the operations counted by the thread, and restarts the timer
+ * parameter: profile
+ * parameter: stage
+ * parameter: timer, started by PROFILE_START or by the last lap
+ * returns: nothing, it's void
+*/
+void profile_lap(struct profile *profile, int stage, struct timespec *timer)
+{
+	struct timespec now;
+	unsigned long long events[PERF_EVENTS];
+	int iterator_counter, iterator_event;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	__atomic_fetch_add(&profile->stage_nanoseconds[stage], nanoseconds(timer, &now), __ATOMIC_RELAXED);
+	__atomic_fetch_add(&profile->stage_calls[stage], 1, __ATOMIC_RELAXED);
+
+	if (profile->hardware_events != 0 && perf_counters_open() != 0 && perf_counters_read(events))
+		for (iterator_event = 0; iterator_event < PERF_EVENTS; iterator_event++)
+			__atomic_fetch_add(&profile->stage_events[stage][iterator_event], events[iterator_event], __ATOMIC_RELAXED);
+
+	for (iterator_counter = 0; iterator_counter < PROFILE_COUNTERS; iterator_counter++)
+	{
+		if (profile_pending[iterator_counter] > 0)
+		{
+			__atomic_fetch_add(&profile->counters[iterator_counter], profile_pending[iterator_counter], __ATOMIC_RELAXED);
+			profile_pending[iterator_counter] = 0;
+		}
+	}
+
+	if (profile->trace != NULL)
+		trace_event(profile->trace, stage_names[stage], -1, timer, &now);
+
+	*timer = now;
+}
+
+/* profile_generation: writes a line of the breakdown with the time and the operations since the last line
+ * parameter: solver context, at the end of a generation, or of the generations between two migrations
+ * returns: nothing, it's void
+*/
+void profile_generation(struct vmpos_context *context)
+{
+	struct profile *profile = &context->profile;
+	FILE *breakdown = open_result_file(context, "profile_generations");
+	struct timespec now;
+	int iterator_stage, iterator_counter;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	if (breakdown != NULL)
+	{
+		fprintf(breakdown, "%d\t%.3f", context->generation, nanoseconds(&profile->last_generation, &now) / 1e6);
+		for (iterator_stage = 0; iterator_stage < PROFILE_STAGES; iterator_stage++)
+			fprintf(breakdown, "\t%.3f", (profile->stage_nanoseconds[iterator_stage] - profile->last_nanoseconds[iterator_stage]) / 1e6);
+		for (iterator_counter = 0; iterator_counter < PROFILE_COUNTERS; iterator_counter++)
+			fprintf(breakdown, "\t%llu", profile->counters[iterator_counter] - profile->last_counters[iterator_counter]);
+		fprintf(breakdown, "\n");
+		fclose(breakdown);
+	}
+
+	/* the workers are idle between the generations, the events of the generation are written */
+	if (profile->trace != NULL)
+	{
+		trace_event(profile->trace, "generation", context->generation, &profile->last_generation, &now);
+		trace_flush(profile->trace);
+	}
+
+	memcpy(profile->last_nanoseconds, profile->stage_nanoseconds, sizeof (profile->last_nanoseconds));
+	memcpy(profile->last_counters, profile->counters, sizeof (profile->last_counters));
+	profile->last_generation = now;
+}
+
+/* per_kilo_instruction: events of a stage per thousand instructions, for the summary
+ * parameter: profile
+ * parameter: stage
+ * parameter: event
+ * parameter: column of the table, it is filled with a dash if the event or the instructions were not read
+ * returns: nothing, it's void
+*/
+static void per_kilo_instruction(struct profile *profile, int stage, int event, char column[])
+{
+	unsigned long long instructions = profile->stage_events[stage][PERF_INSTRUCTIONS];
+
+	if ((profile->hardware_events & (1 << event)) && (profile->hardware_events & (1 << PERF_INSTRUCTIONS)) && instructions > 0)
+		snprintf(column, 16, "%.3f", 1000.0 * profile->stage_events[stage][event] / instructions);
+	else
+		snprintf(column, 16, "-");
+}
+
+/* profile_summary: writes the summary table of the profile of the last solve, until its last generation
+ * parameter: solver context
+ * parameter: file to write the table, stdout for example
+ * returns: nothing, it's void
+*/
+void profile_summary(struct vmpos_context *context, FILE *file)
+{
+	struct profile *profile = &context->profile;
+	double wall_milliseconds = nanoseconds(&profile->start, &profile->last_generation) / 1e6;
+	double stage_milliseconds;
+	unsigned long long cycles;
+	char ipc[16], cache_misses[16], branch_misses[16];
+	int iterator_stage, iterator_counter;
+
+	fprintf(file, "\nPROFILE OF THE SOLVE: %d generations in %.3f ms (the stages of Q are the time of all the threads)\n", context->generation, wall_milliseconds);
+	fprintf(file, "%-26s %12s %14s %8s %14s", "stage", "calls", "total ms", "% wall", "mean us");
+	if (profile->hardware_events != 0)
+		fprintf(file, " %14s %8s %12s %12s", "Mcycles", "IPC", "cache MPKI", "branch MPKI");
+	fprintf(file, "\n");
+
+	for (iterator_stage = 0; iterator_stage < PROFILE_STAGES; iterator_stage++)
+	{
+		if (profile->stage_calls[iterator_stage] == 0)
+			continue;
+
+		stage_milliseconds = profile->stage_nanoseconds[iterator_stage] / 1e6;
+		fprintf(file, "%-26s %12llu %14.3f %8.1f %14.3f", stage_names[iterator_stage], profile->stage_calls[iterator_stage], stage_milliseconds,
+			wall_milliseconds > 0.0 ? 100.0 * stage_milliseconds / wall_milliseconds : 0.0, 1000.0 * stage_milliseconds / profile->stage_calls[iterator_stage]);
+
+		/* instructions per cycle, and cache and branch misses per thousand instructions */
+		if (profile->hardware_events != 0)
+		{
+			cycles = profile->stage_events[iterator_stage][PERF_CYCLES];
+
+			if ((profile->hardware_events & (1 << PERF_INSTRUCTIONS)) && cycles > 0)
+				snprintf(ipc, sizeof (ipc), "%.3f", (double) profile->stage_events[iterator_stage][PERF_INSTRUCTIONS] / cycles);
+			else
+				snprintf(ipc, sizeof (ipc), "-");
+
+			per_kilo_instruction(profile, iterator_stage, PERF_CACHE_MISSES, cache_misses);
+			per_kilo_instruction(profile, iterator_stage, PERF_BRANCH_MISSES, branch_misses);
+
+			fprintf(file, " %14.3f %8s %12s %12s", cycles / 1e6, ipc, cache_misses, branch_misses);
+		}
+		fprintf(file, "\n");
+	}
+
+	fprintf(file, "%-26s %12s\n", "operation", "count");
+	for (iterator_counter = 0; iterator_counter < PROFILE_COUNTERS; iterator_counter++)
+		fprintf(file, "%-26s %12llu\n", counter_names[iterator_counter], profile->counters[iterator_counter]);
+}
+
+/* profile_finish: ends the profile of a solve, closing its trace
+ * parameter: solver context
+ * returns: nothing, it's void
+*/
+void profile_finish(struct vmpos_context *context)
+{
+	if (context->profile.trace != NULL)
+	{
+		trace_close(context->profile.trace);
+		context->profile.trace = NULL;
+	}
+}
+
+#endif
@@ -0,0 +1,120 @@
+/*
+ * profile.h: Virtual Machine Placement with OverSubscription Problem - Stage Profiler Header
+ * Date: 17-10-2026
+ *
+ * The profiler measures the time of every stage of the memetic algorithm with the monotonic
+ * clock and counts the hot operations: VM moves, updates of the commitment matrix, failed scans
+ * of candidate PMs in the repair and duplicates rejected by the Pareto archive. It is compiled
+ * only with -DVMPOS_PROFILE; without it the macros are empty and the profiler costs nothing.
+ *
+ * A stage is measured with a lap timer, started once and read after each stage:
+ *
+ *     PROFILE_START(timer);
+ *     repair_population(...);
+ *     PROFILE_LAP(context, PROFILE_REPARATION, timer);
+ *
+ * The counters are kept by each thread and added to the profile of the context in the lap
+ * of the stage that counted them, so the threads do not share a counter in the hot loops and
+ * the solves of different contexts are profiled apart. The stages of the individuals of Q
+ * run in several threads, their time is the sum of the time of all the threads, and the
+ * offspring stage is the wall time of all of them. With the trace_path of the context, the
+ * laps are also written as a timeline (see trace.h). With the hardware_counters of the
+ * context, each lap also adds the cycles, instructions, cache misses and branch misses of its
+ * thread since the last lap or start (see perf_counters.h); the offspring stage only gets the
+ * events of the thread of the solve outside the stages of Q.
+*/
+
+#ifndef PROFILE_H
+#define PROFILE_H
+
+/* include libraries */
+#include <stdio.h>
+#include <time.h>
+
+/* include hardware counters header, with the events */
+#include "perf_counters.h"
+
+/* stages of the memetic algorithm */
+#define PROFILE_INITIALIZATION 0
+#define PROFILE_CROSSOVER 1
+#define PROFILE_UTILIZATION 2
+#define PROFILE_COMMITMENT 3
+#define PROFILE_EVALUATION 4
+#define PROFILE_MUTATION 5
+#define PROFILE_REPARATION 6
+#define PROFILE_LOCAL_SEARCH 7
+#define PROFILE_OBJECTIVES 8
+#define PROFILE_OFFSPRING 9
+#define PROFILE_SORTING 10
+#define PROFILE_PARETO 11
+#define PROFILE_EVOLUTION 12
+#define PROFILE_MIGRATION 13
+#define PROFILE_REPORT 14
+#define PROFILE_STAGES 15
+
+/* counters of hot operations */
+#define PROFILE_VM_MOVES 0
+#define PROFILE_COMMITMENT_UPDATES 1
+#define PROFILE_FAILED_REPAIR_SCANS 2
+#define PROFILE_ARCHIVE_DUPLICATES 3
+#define PROFILE_COUNTERS 4
+
+struct vmpos_context;
+struct trace;
+
+/* structure of the profile of a solve */
+struct profile
+{
+	/* nanoseconds and times run of each stage, and count of each operation */
+	unsigned long long stage_nanoseconds[PROFILE_STAGES];
+	unsigned long long stage_calls[PROFILE_STAGES];
+	unsigned long long counters[PROFILE_COUNTERS];
+	/* hardware events of each stage, and events read, one bit per event (0 without hardware counters) */
+	unsigned long long stage_events[PROFILE_STAGES][PERF_EVENTS];
+	int hardware_events;
+	/* the same values at the last line of the breakdown by generation */
+	unsigned long long last_nanoseconds[PROFILE_STAGES];
+	unsigned long long last_counters[PROFILE_COUNTERS];
+	/* beginning of the solve and of the generation of the last line of the breakdown */
+	struct timespec start;
+	struct timespec last_generation;
+	/* timeline of the laps, NULL if the context has no trace_path */
+	struct trace *trace;
+};
+
+#ifdef VMPOS_PROFILE
+
+/* counts of the thread not yet added to a profile */
+extern _Thread_local unsigned long long profile_pending[PROFILE_COUNTERS];
+
+#define PROFILE_START(timer) struct timespec timer; clock_gettime(CLOCK_MONOTONIC, &timer); perf_counters_mark()
+#define PROFILE_RESTART(timer) (clock_gettime(CLOCK_MONOTONIC, &timer), perf_counters_mark())
+#define PROFILE_LAP(context, stage, timer) profile_lap(&(context)->profile, stage, &timer)
+#define PROFILE_COUNT(counter) (profile_pending[counter]++)
+#define PROFILE_RESET(context) profile_reset(context)
+#define PROFILE_GENERATION(context) profile_generation(context)
+#define PROFILE_SUMMARY(context, file) profile_summary(context, file)
+#define PROFILE_FINISH(context) profile_finish(context)
+
+/* function headers definitions */
+void profile_reset(struct vmpos_context *context);
+void profile_lap(struct profile *profile, int stage, struct timespec *timer);
+void profile_generation(struct vmpos_context *context);
+void profile_summary(struct vmpos_context *context, FILE *file);
+void profile_finish(struct vmpos_context *context);
+
+#else
+
+#define PROFILE_START(timer)
+#define PROFILE_RESTART(timer)
+#define PROFILE_LAP(context, stage, timer)
+#define PROFILE_COUNT(counter)
+
+#define PROFILE_RESET(context)
+#define PROFILE_GENERATION(context)
+#define PROFILE_SUMMARY(context, file)
+#define PROFILE_FINISH(context)
+
+#endif
+
+#endif
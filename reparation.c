@@ -14,95 +14,111 @@
 #include "reparation.h"
 #include "commitment.h"
 #include "common.h"
+#include "evaluation.h"
 
 /* reparation: reparates the population
- * parameter: population matrix
- * parameter: utilization tridimentional matrix
+ * parameter: solver context
+ * parameter: population, with its utilization and evaluation loaded
  * parameter: commitment matrix
  * parameter: physical machines matrix
  * parameter: virtual machines matrix
+ * parameter: number of physical machines usable by each individual
  * parameter: number of individuals
  * parameter: number of physical machines
  * parameter: number of virtual machines
- * returns: reparated population matrix
+ * parameter: random number stream of each individual
+ * returns: reparated population
 */
-int **reparation(int **population, int ***utilization, float **cm, int **H, int **V, int number_of_individuals, int h_size, int v_size, int CRITICAL_SERVICES)
+struct population *reparation(struct vmpos_context *context, struct population *population, float **cm, int **H, int **V, int *h_sizes, int number_of_individuals, int h_size, int v_size, int CRITICAL_SERVICES, struct rng *streams)
 {
 	/* repairs population from not factible individuals */
-	repair_population(population, utilization, cm, H, V, number_of_individuals, h_size, v_size, CRITICAL_SERVICES);
+	repair_population(context, population, cm, H, V, h_sizes, number_of_individuals, h_size, v_size, CRITICAL_SERVICES, streams);
 	return population;
 }
 
 /* reparation: reparates the population
- * parameter: population matrix
- * parameter: utilization of the physical machines matrix
+ * parameter: solver context
+ * parameter: population, with its utilization and evaluation loaded
  * parameter: commitment matrix
  * parameter: physical machines matrix
  * parameter: virtual machines matrix
+ * parameter: number of physical machines usable by each individual
  * parameter: number of individuals
  * parameter: number of physical machines
  * parameter: number of virtual machines
+ * parameter: random number stream of each individual
  * returns: reparated population matrix
 */
-void repair_population(int **population, int ***utilization, float **cm, int **H, int **V, int number_of_individuals, int h_size, int v_size, int CRITICAL_SERVICES)
+void repair_population(struct vmpos_context *context, struct population *population, float **cm, int **H, int **V, int *h_sizes, int number_of_individuals, int h_size, int v_size, int CRITICAL_SERVICES, struct rng *streams)
 {
 	/* iterators */
 	int iterator_individual = 0;
-	int iterator_virtual = 0;
-	int iterator_physical = 0;
-	int factibility = 1;
 
 	/* iterate on individuals */
 	for (iterator_individual = 0; iterator_individual < number_of_individuals ; iterator_individual++)
 	{
-		/* every individual is feasible until it's probed other thing */		
-		factibility = 1;
-		/* constraint: Provision of VMs with Critical Services. Virtual machines with CRITICAL SERVICES have to be placed mandatorily */
-		for (iterator_virtual = 0; iterator_virtual < v_size; iterator_virtual++)
-		{
-			if (V[iterator_virtual][3] == CRITICAL_SERVICES && population[iterator_individual][iterator_virtual] == 0)
-			{
-				factibility = 0;
-				break;
-			}
-		}
-		/* constraints: Resource capacity of physical machines. Iterate on physical machines */
-		for (iterator_physical = 0; iterator_physical < h_size ; iterator_physical++)
-		{
-			// Checks whether the physical machine is being used
-			if (cm[iterator_individual][iterator_physical] > 0.0)
-				/* if any physical machine is overloaded on any resource, the individual is not factible */
-				if (is_overloaded(H, utilization, cm, iterator_individual, iterator_physical))
-				{
-					factibility = 0;
-					break;
-				}
-		}
-
 		/* if the individual is not factible */
-		if (factibility == 0)
+		if (!is_factible(population, cm, H, V, h_size, v_size, CRITICAL_SERVICES, iterator_individual))
 		{
-			repair_individual(population, utilization, cm, H, V, number_of_individuals, h_size, v_size, CRITICAL_SERVICES, iterator_individual);
+			repair_individual(context, population, cm, H, V, h_sizes, h_size, v_size, CRITICAL_SERVICES, iterator_individual, &streams[iterator_individual]);
 		}
 	}
 }
 
+/* is_factible: verifies the constraints of an individual
+ * parameter: population, with its utilization and evaluation loaded
+ * parameter: commitment matrix
+ * parameter: physical machines matrix
+ * parameter: virtual machines matrix
+ * parameter: number of physical machines
+ * parameter: number of virtual machines
+ * parameter: identificator of the individual to verify
+ * returns: 1 if the individual is factible, otherwise returns 0
+*/
+int is_factible(struct population *population, float **cm, int **H, int **V, int h_size, int v_size, int CRITICAL_SERVICES, int iterator_individual)
+{
+	/* iterators */
+	int iterator_virtual = 0;
+	int iterator_physical = 0;
+	int *individual = INDIVIDUAL(population, iterator_individual);
+
+	/* constraint: Provision of VMs with Critical Services. Virtual machines with CRITICAL SERVICES have to be placed mandatorily */
+	for (iterator_virtual = 0; iterator_virtual < v_size; iterator_virtual++)
+	{
+		if (V[3][iterator_virtual] == CRITICAL_SERVICES && individual[iterator_virtual] == 0)
+			return 0;
+	}
+	/* constraints: Resource capacity of physical machines. Iterate on physical machines */
+	for (iterator_physical = 0; iterator_physical < h_size ; iterator_physical++)
+	{
+		// Checks whether the physical machine is being used
+		if (cm[iterator_individual][iterator_physical] > 0.0)
+			/* if any physical machine is overloaded on any resource, the individual is not factible */
+			if (is_overloaded(H, population, cm, iterator_individual, iterator_physical))
+				return 0;
+	}
+	/* every individual is factible until it's probed other thing */
+	return 1;
+}
+
 /* repair_individual: repairs not factible individuals
- * parameter: population matrix
- * parameter: utilization of the physical machines matrix
+ * parameter: solver context
+ * parameter: population, with its utilization and evaluation loaded
  * parameter: commitment matrix
  * parameter: physical machines matrix
  * parameter: virtual machines matrix
- * parameter: number of individuals
+ * parameter: number of physical machines usable by each individual
  * parameter: number of physical machines
  * parameter: number of virtual machines
  * parameter: identificator of the not factible individual to repair
+ * parameter: random number stream of the individual
  * returns: nothing, it's void()
 */
-void repair_individual(int **population, int ***utilization, float **cm, int **H, int **V, int number_of_individuals, int h_size, int v_size, int CRITICAL_SERVICES, int individual)
+void repair_individual(struct vmpos_context *context, struct population *population, float **cm, int **H, int **V, int *h_sizes, int h_size, int v_size, int CRITICAL_SERVICES, int individual, struct rng *rng)
 {
 	int iterator_virtual = 0;
 	int iterator_virtual2 = 0;
+	int next_virtual = 0;
 	int iterator_virtual_again=0;
 	int iterator_physical = 0;	
 	/* every individual is not feasible until it's probed other thing */		
@@ -114,57 +130,47 @@ void repair_individual(int **population, int ***utilization, float **cm, int **H
 
 	float available_cpus = 0.0, available_memory = 0.0;
 
+	/* genes of the individual to repair */
+	int *genes = INDIVIDUAL(population, individual);
+
 	/* iterate on each virtual machine to search for overloaded physical machines */
 	for (iterator_virtual = 0; iterator_virtual < v_size; iterator_virtual++)
 	{
 		/* if the virtual machine was placed */
-		if (population[individual][iterator_virtual] != 0)
+		if (genes[iterator_virtual] != 0)
 		{
 			migration = 0;
 			/* verify is the physical machine assigned is overloaded in any physical resource */
-			if ( is_overloaded(H, utilization, cm, individual, ( population[individual][iterator_virtual] - 1 )) )
+			if ( is_overloaded(H, population, cm, individual, ( genes[iterator_virtual] - 1 )) )
 			{
 				/* we search for a correct candidate for VM "migration" (it is not really a migration, only a physical machine change) */
-				candidate = rand() % global_h_sizes[individual];
+				candidate = rng_bounded(rng, h_sizes[individual]);
 
-				for (iterator_physical=0; iterator_physical < global_h_sizes[individual]; iterator_physical++)
+				for (iterator_physical=0; iterator_physical < h_sizes[individual]; iterator_physical++)
 				{
 					if (cm[individual][candidate] > 1.0)
 					{
-						available_cpus = (float) H[candidate][0] * cm[individual][candidate];
-						available_memory = (float) H[candidate][1] * cm[individual][candidate];
+						available_cpus = (float) H[0][candidate] * cm[individual][candidate];
+						available_memory = (float) H[1][candidate] * cm[individual][candidate];
 					}
 					else
 					{
-						available_cpus = (float) H[candidate][0];
-						available_memory = (float) H[candidate][1];
+						available_cpus = (float) H[0][candidate];
+						available_memory = (float) H[1][candidate];
 					}
-					if ( (float) utilization[individual][candidate][0] + (float) V[iterator_virtual][0] <= available_cpus &&
-	   			   	 	 (float) utilization[individual][candidate][1] + (float) V[iterator_virtual][1] <= available_memory && 
-						 (float) utilization[individual][candidate][2] + (float) V[iterator_virtual][2] <= (float) H[candidate][2] )
+					if ( (float) UTILIZATION(population, individual, candidate)[0] + (float) V[0][iterator_virtual] <= available_cpus &&
+	   			   	 	 (float) UTILIZATION(population, individual, candidate)[1] + (float) V[1][iterator_virtual] <= available_memory && 
+						 (float) UTILIZATION(population, individual, candidate)[2] + (float) V[2][iterator_virtual] <= (float) H[2][candidate] )
 					{
-						/* delete requirements from physical machine migration source */
-						utilization[individual][population[individual][iterator_virtual]-1][0] -= V[iterator_virtual][0];
-						utilization[individual][population[individual][iterator_virtual]-1][1] -= V[iterator_virtual][1];
-						utilization[individual][population[individual][iterator_virtual]-1][2] -= V[iterator_virtual][2];
-
-						/* add requirements from physical machine migration destination */
-						utilization[individual][candidate][0] += V[iterator_virtual][0];
-						utilization[individual][candidate][1] += V[iterator_virtual][1];
-						utilization[individual][candidate][2] += V[iterator_virtual][2];
-
-						/* refresh the population */
-						population[individual][iterator_virtual] = candidate + 1;
-
-						// updte the commitment matrix
-						update_commitment_line (population, cm, V, individual, h_size, v_size, CRITICAL_SERVICES);
+						/* move the requirements from the source to the destination physical machine, refresh the population and the commitment matrix */
+						move_virtual_machine(context, population, cm, H, V, individual, iterator_virtual, candidate + 1, CRITICAL_SERVICES);
 
 						/* virtual machine correctly "migrated" */
 						migration = 1;
 						break;
 					}
 
-					if (candidate < global_h_sizes[individual] - 1) //** Aqui estava com: candidate < h_size, e ele incrementava o candidato, mas não tem MF igual a h_size, tem que ser menor
+					if (candidate < h_sizes[individual] - 1) //** Aqui estava com: candidate < h_size, e ele incrementava o candidato, mas não tem MF igual a h_size, tem que ser menor
 					{
 						candidate++;
 					}
@@ -175,17 +181,13 @@ void repair_individual(int **population, int ***utilization, float **cm, int **H
 				}
 				if (!migration)
 				{
-					if (V[iterator_virtual][3]!=CRITICAL_SERVICES)
-					{
-						utilization[individual][population[individual][iterator_virtual]-1][0] -= V[iterator_virtual][0];
-						utilization[individual][population[individual][iterator_virtual]-1][1] -= V[iterator_virtual][1];
-						utilization[individual][population[individual][iterator_virtual]-1][2] -= V[iterator_virtual][2];
-						
-						/* refresh the population */
-						population[individual][iterator_virtual] = 0;
+					/* no candidate PM had space for the VM */
+					PROFILE_COUNT(PROFILE_FAILED_REPAIR_SCANS);
 
-						// updte the commitment matrix
-						update_commitment_line (population, cm, V, individual, h_size, v_size, CRITICAL_SERVICES);
+					if (V[3][iterator_virtual]!=CRITICAL_SERVICES)
+					{
+						/* delete requirements from the physical machine, refresh the population and the commitment matrix */
+						move_virtual_machine(context, population, cm, H, V, individual, iterator_virtual, 0, CRITICAL_SERVICES);
 
 						/* virtual machine correctly "deleted" */
 						migration = 1;
@@ -193,27 +195,20 @@ void repair_individual(int **population, int ***utilization, float **cm, int **H
 				}
 				if(!migration)
 				{
-					// Looking for no critial VMs in the same PM to turn off
-					for (iterator_virtual2 = 0; iterator_virtual2 < v_size; iterator_virtual2++)
+					// Looking for no critial VMs in the same PM to turn off, in the list of the VMs of the PM
+					for (iterator_virtual2 = FIRST_VIRTUAL_MACHINE(population, individual, genes[iterator_virtual]); iterator_virtual2 != -1; iterator_virtual2 = next_virtual)
 					{
-						if ( population[individual][iterator_virtual2] == population[individual][iterator_virtual] &&
-							 V[iterator_virtual2][3] != CRITICAL_SERVICES )
-						{
-							/* delete requirements from physical machine migration source */
-							utilization[individual][population[individual][iterator_virtual]-1][0] -= V[iterator_virtual2][0];
-							utilization[individual][population[individual][iterator_virtual]-1][1] -= V[iterator_virtual2][1];
-							utilization[individual][population[individual][iterator_virtual]-1][2] -= V[iterator_virtual2][2];
-							
-							/* refresh the population */
-							population[individual][iterator_virtual2] = 0;
+						next_virtual = NEXT_VIRTUAL_MACHINE(population, individual, iterator_virtual2);
 
-							// updte the commitment matrix
-							update_commitment_line (population, cm, V, individual, h_size, v_size, CRITICAL_SERVICES);
+						if ( V[3][iterator_virtual2] != CRITICAL_SERVICES )
+						{
+							/* delete requirements from physical machine migration source, refresh the population and the commitment matrix */
+							move_virtual_machine(context, population, cm, H, V, individual, iterator_virtual2, 0, CRITICAL_SERVICES);
 
 							/* virtual machine correctly "deleted" */
 							migration = 1;
 
-							if ( !is_overloaded(H, utilization, cm, individual, ( population[individual][iterator_virtual] - 1 )) )
+							if ( !is_overloaded(H, population, cm, individual, ( genes[iterator_virtual] - 1 )) )
 								break;
 						}
 					}		
@@ -226,18 +221,20 @@ void repair_individual(int **population, int ***utilization, float **cm, int **H
 
 /* is_overloaded: verifies if the PM is overloaded
  * parameter: physical machines matrix
- * parameter: utilization of the physical machines matrix
+ * parameter: population, with its utilization and evaluation loaded
  * parameter: commitment matrix
  * parameter: the individual to verify
  * parameter: the physical machines identificaion
  * returns: 1 if is overloaded, otherwise returns 0
 */
-int is_overloaded(int **H, int ***utilization, float **cm, int individual, int physical)
+int is_overloaded(int **H, struct population *population, float **cm, int individual, int physical)
 {
+	int *utilization = UTILIZATION(population, individual, physical);
+
 	// If the use of the VM exceeds the capacity of the physical machine returns 1, otherwise returns 0
-	if ( ( (float) utilization[individual][physical][0] > (float) H[physical][0] * cm[individual][physical])
-	||   ( (float) utilization[individual][physical][1] > (float) H[physical][1] * cm[individual][physical])
-	||   ( (float) utilization[individual][physical][2] > (float) H[physical][2] ) )
+	if ( ( (float) utilization[0] > (float) H[0][physical] * cm[individual][physical])
+	||   ( (float) utilization[1] > (float) H[1][physical] * cm[individual][physical])
+	||   ( (float) utilization[2] > (float) H[2][physical] ) )
 	{
 		return 1;
 	}
@@ -17,10 +17,13 @@
 #include <math.h>
 #include <time.h>
 
-extern int *global_h_sizes;
+#include "population.h"
+#include "rng.h"
+#include "context.h"
 
 /* function headers definitions */
-int **reparation(int **population, int ***utilization, float **cm, int **H, int **V, int number_of_individuals, int h_size, int v_size, int CS);
-void repair_population(int **population, int ***utilization, float **cm, int **H, int **V, int number_of_individuals, int h_size, int v_size, int CS);
-void repair_individual(int **population, int ***utilization, float **cm, int **H, int **V, int number_of_individuals, int h_size, int v_size, int CS, int individual);
-int is_overloaded(int **H, int ***utilization, float **cm, int individual, int physical);
+struct population *reparation(struct vmpos_context *context, struct population *population, float **cm, int **H, int **V, int *h_sizes, int number_of_individuals, int h_size, int v_size, int CS, struct rng *streams);
+void repair_population(struct vmpos_context *context, struct population *population, float **cm, int **H, int **V, int *h_sizes, int number_of_individuals, int h_size, int v_size, int CS, struct rng *streams);
+int is_factible(struct population *population, float **cm, int **H, int **V, int h_size, int v_size, int CS, int individual);
+void repair_individual(struct vmpos_context *context, struct population *population, float **cm, int **H, int **V, int *h_sizes, int h_size, int v_size, int CS, int individual, struct rng *rng);
+int is_overloaded(int **H, struct population *population, float **cm, int individual, int physical);
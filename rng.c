@@ -0,0 +1,46 @@
+/*
+ * rng.c: Virtual Machine Placement with OverSubscription Problem - Random Number Generator
+ * Date: 17-10-2026
+ *
+ * The 256 bits of state are filled with splitmix64, which gives well mixed states even for
+ * close seeds such as 1, 2, 3, and never gives the all zero state that xoshiro can not leave.
+*/
+
+/* include random number generator header */
+#include "rng.h"
+
+/* splitmix64: next value of a splitmix64 sequence
+ * parameter: state of the sequence
+ * returns: mixed value of 64 bits
+*/
+static uint64_t splitmix64(uint64_t *state)
+{
+	uint64_t z = (*state += 0x9E3779B97F4A7C15ULL);
+
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+	return z ^ (z >> 31);
+}
+
+/* rng_seed: initializes a stream from a seed
+ * parameter: stream
+ * parameter: seed
+ * returns: nothing, it's void
+*/
+void rng_seed(struct rng *rng, uint64_t seed)
+{
+	rng->state[0] = splitmix64(&seed);
+	rng->state[1] = splitmix64(&seed);
+	rng->state[2] = splitmix64(&seed);
+	rng->state[3] = splitmix64(&seed);
+}
+
+/* rng_split: initializes a new stream with a seed drawn from another stream
+ * parameter: stream that gives the seed
+ * parameter: new stream
+ * returns: nothing, it's void
+*/
+void rng_split(struct rng *rng, struct rng *stream)
+{
+	rng_seed(stream, rng_next(rng));
+}
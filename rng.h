@@ -0,0 +1,86 @@
+/*
+ * rng.h: Virtual Machine Placement with OverSubscription Problem - Random Number Generator Header
+ * Date: 17-10-2026
+ *
+ * xoshiro256** generator (Blackman and Vigna) with an explicit state, so every part of the
+ * algorithm that needs random numbers owns its stream and no stream is shared between threads.
+ * The state is seeded with splitmix64 from a 64 bit seed, and a stream can be split in a new
+ * independent stream. Bounded integers are drawn without the bias of the % operator.
+*/
+
+#ifndef RNG_H
+#define RNG_H
+
+/* include libraries */
+#include <stdint.h>
+
+/* state of a stream of random numbers */
+struct rng
+{
+	uint64_t state[4];
+};
+
+/* rng_rotate: rotates a 64 bit value to the left
+ * parameter: value
+ * parameter: bits to rotate
+ * returns: rotated value
+*/
+static inline uint64_t rng_rotate(uint64_t value, int bits)
+{
+	return (value << bits) | (value >> (64 - bits));
+}
+
+/* rng_next: next random number of a stream
+ * parameter: stream
+ * returns: random number of 64 bits
+*/
+static inline uint64_t rng_next(struct rng *rng)
+{
+	uint64_t *s = rng->state;
+	uint64_t result = rng_rotate(s[1] * 5, 7) * 9;
+	uint64_t t = s[1] << 17;
+
+	s[2] ^= s[0];
+	s[3] ^= s[1];
+	s[1] ^= s[2];
+	s[0] ^= s[3];
+	s[2] ^= t;
+	s[3] = rng_rotate(s[3], 45);
+
+	return result;
+}
+
+/* rng_bounded: random integer lower than a bound, without bias (Lemire's multiply and reject)
+ * parameter: stream
+ * parameter: bound, greater than 0
+ * returns: random integer from 0 to bound - 1
+*/
+static inline uint32_t rng_bounded(struct rng *rng, uint32_t bound)
+{
+	uint64_t product = (rng_next(rng) >> 32) * bound;
+	uint32_t threshold;
+
+	/* the low part of the product is lower than 2^32 mod bound only for the values to reject */
+	if ((uint32_t) product < bound)
+	{
+		threshold = -bound % bound;
+		while ((uint32_t) product < threshold)
+			product = (rng_next(rng) >> 32) * bound;
+	}
+	return (uint32_t) (product >> 32);
+}
+
+/* rng_uniform: random real number in [0, 1)
+ * parameter: stream
+ * returns: random number with 53 random bits
+*/
+static inline double rng_uniform(struct rng *rng)
+{
+	return (rng_next(rng) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+/* function headers definitions */
+void rng_seed(struct rng *rng, uint64_t seed);
+void rng_split(struct rng *rng, struct rng *stream);
+
+#endif
@@ -0,0 +1,258 @@
+/*
+ * thread_pool.c: Virtual Machine Placement with OverSubscription Problem - Thread Pool
+ * Date: 17-10-2026
+ *
+ * The queues are ranges of chunk numbers. A worker takes chunks from the beginning of its own
+ * range and steals from the end of the range of another worker, and it holds only one lock at a
+ * time. The chunks are only consumed during a round, so a worker that finds all the queues empty
+ * has finished its part of the round.
+*/
+
+/* include libraries */
+#include <unistd.h>
+
+/* include thread pool header */
+#include "thread_pool.h"
+
+/* take_chunk: takes a chunk of the round for a worker, from its own queue or stolen from another queue
+ * parameter: thread pool
+ * parameter: worker identificator
+ * returns: chunk number, -1 if there are no chunks left
+*/
+static int take_chunk(struct thread_pool *pool, int worker)
+{
+	struct thread_pool_queue *queue = &pool->queues[worker];
+	struct thread_pool_queue *victim;
+	int chunk = -1;
+	int iterator_worker, stolen_first, stolen_last;
+
+	pthread_mutex_lock(&queue->lock);
+	if (queue->first < queue->last)
+		chunk = queue->first++;
+	pthread_mutex_unlock(&queue->lock);
+
+	if (chunk != -1)
+		return chunk;
+
+	/* steal the last half of the chunks of the first worker that has some */
+	for (iterator_worker = 1; iterator_worker < pool->number_of_threads; iterator_worker++)
+	{
+		victim = &pool->queues[(worker + iterator_worker) % pool->number_of_threads];
+
+		pthread_mutex_lock(&victim->lock);
+		stolen_last = victim->last;
+		stolen_first = victim->last - (victim->last - victim->first + 1) / 2;
+		victim->last = stolen_first;
+		pthread_mutex_unlock(&victim->lock);
+
+		if (stolen_first < stolen_last)
+		{
+			pthread_mutex_lock(&queue->lock);
+			queue->first = stolen_first + 1;
+			queue->last = stolen_last;
+			pthread_mutex_unlock(&queue->lock);
+
+			return stolen_first;
+		}
+	}
+	return -1;
+}
+
+/* run_round: processes chunks of the round until there are no chunks left
+ * parameter: thread pool
+ * parameter: worker identificator
+ * returns: nothing, it's void
+*/
+static void run_round(struct thread_pool *pool, int worker)
+{
+	int chunk, item, last_item;
+
+	while ((chunk = take_chunk(pool, worker)) != -1)
+	{
+		last_item = (chunk + 1) * pool->chunk_size;
+		if (last_item > pool->number_of_items)
+			last_item = pool->number_of_items;
+
+		for (item = chunk * pool->chunk_size; item < last_item; item++)
+			pool->task(pool->data, item, worker);
+	}
+}
+
+/* worker_thread: waits for the rounds and works on them until the pool is freed
+ * parameter: thread pool
+ * returns: NULL
+*/
+static void *worker_thread(void *argument)
+{
+	struct thread_pool *pool = (struct thread_pool *) argument;
+	int worker, round = 0;
+
+	/* the worker identificator is given in the order the threads start */
+	pthread_mutex_lock(&pool->lock);
+	worker = ++pool->working;
+	if (pool->working == pool->number_of_threads - 1)
+		pthread_cond_signal(&pool->round_finished);
+
+	while (1)
+	{
+		while (pool->round == round && !pool->stop)
+			pthread_cond_wait(&pool->round_started, &pool->lock);
+
+		if (pool->stop)
+			break;
+
+		round = pool->round;
+		pthread_mutex_unlock(&pool->lock);
+
+		run_round(pool, worker);
+
+		pthread_mutex_lock(&pool->lock);
+		if (--pool->working == 0)
+			pthread_cond_signal(&pool->round_finished);
+	}
+	pthread_mutex_unlock(&pool->lock);
+
+	return NULL;
+}
+
+/* thread_pool_create: creates a thread pool and starts its workers
+ * parameter: number of threads, counting the calling thread
+ * returns: thread pool
+*/
+struct thread_pool *thread_pool_create(int number_of_threads)
+{
+	int iterator_worker;
+	struct thread_pool *pool = (struct thread_pool *) malloc (sizeof (struct thread_pool));
+
+	if (number_of_threads < 1)
+		number_of_threads = 1;
+
+	if (pool == NULL)
+	{
+		printf ("[ERROR]: Problem with memory space. Function malloc returned NULL!\n");
+		exit (EXIT_FAILURE);
+	}
+
+	pool->number_of_threads = number_of_threads;
+	pool->threads = (pthread_t *) malloc (number_of_threads * sizeof (pthread_t));
+	pool->queues = (struct thread_pool_queue *) malloc (number_of_threads * sizeof (struct thread_pool_queue));
+
+	if (pool->threads == NULL || pool->queues == NULL)
+	{
+		printf ("[ERROR]: Problem with memory space. Function malloc returned NULL!\n");
+		exit (EXIT_FAILURE);
+	}
+
+	for (iterator_worker = 0; iterator_worker < number_of_threads; iterator_worker++)
+	{
+		pthread_mutex_init(&pool->queues[iterator_worker].lock, NULL);
+		pool->queues[iterator_worker].first = pool->queues[iterator_worker].last = 0;
+	}
+
+	pthread_mutex_init(&pool->lock, NULL);
+	pthread_cond_init(&pool->round_started, NULL);
+	pthread_cond_init(&pool->round_finished, NULL);
+	pool->round = 0;
+	pool->working = 0;
+	pool->stop = 0;
+
+	/* the calling thread is the worker 0, the others are created */
+	for (iterator_worker = 1; iterator_worker < number_of_threads; iterator_worker++)
+	{
+		if (pthread_create(&pool->threads[iterator_worker], NULL, worker_thread, pool) != 0)
+		{
+			printf ("[ERROR]: Problem creating the threads. Function pthread_create failed!\n");
+			exit (EXIT_FAILURE);
+		}
+	}
+
+	/* wait for all the workers to take their identificators */
+	pthread_mutex_lock(&pool->lock);
+	while (pool->working < number_of_threads - 1)
+		pthread_cond_wait(&pool->round_finished, &pool->lock);
+	pool->working = 0;
+	pthread_mutex_unlock(&pool->lock);
+
+	return pool;
+}
+
+/* thread_pool_run: runs a task over the items 0..number_of_items-1 with all the workers and waits for it to finish
+ * parameter: thread pool
+ * parameter: number of items
+ * parameter: task, called once for each item
+ * parameter: data given to the task
+ * returns: nothing, it's void
+*/
+void thread_pool_run(struct thread_pool *pool, int number_of_items, thread_pool_task task, void *data)
+{
+	int iterator_worker, number_of_chunks;
+
+	if (number_of_items <= 0)
+		return;
+
+	/* chunks of the same size, given in equal parts to the queues of the workers */
+	number_of_chunks = pool->number_of_threads * THREAD_POOL_CHUNKS_PER_WORKER;
+	pool->chunk_size = (number_of_items + number_of_chunks - 1) / number_of_chunks;
+	number_of_chunks = (number_of_items + pool->chunk_size - 1) / pool->chunk_size;
+
+	pool->task = task;
+	pool->data = data;
+	pool->number_of_items = number_of_items;
+
+	for (iterator_worker = 0; iterator_worker < pool->number_of_threads; iterator_worker++)
+	{
+		pool->queues[iterator_worker].first = (int) ((long) iterator_worker * number_of_chunks / pool->number_of_threads);
+		pool->queues[iterator_worker].last = (int) ((long) (iterator_worker + 1) * number_of_chunks / pool->number_of_threads);
+	}
+
+	/* a new round, the queues are seen by the workers through the lock */
+	pthread_mutex_lock(&pool->lock);
+	pool->working = pool->number_of_threads - 1;
+	pool->round++;
+	pthread_cond_broadcast(&pool->round_started);
+	pthread_mutex_unlock(&pool->lock);
+
+	run_round(pool, 0);
+
+	pthread_mutex_lock(&pool->lock);
+	while (pool->working > 0)
+		pthread_cond_wait(&pool->round_finished, &pool->lock);
+	pthread_mutex_unlock(&pool->lock);
+}
+
+/* thread_pool_free: stops the workers and frees the thread pool
+ * parameter: thread pool
+ * returns: nothing, it's void
+*/
+void thread_pool_free(struct thread_pool *pool)
+{
+	int iterator_worker;
+
+	pthread_mutex_lock(&pool->lock);
+	pool->stop = 1;
+	pthread_cond_broadcast(&pool->round_started);
+	pthread_mutex_unlock(&pool->lock);
+
+	for (iterator_worker = 1; iterator_worker < pool->number_of_threads; iterator_worker++)
+		pthread_join(pool->threads[iterator_worker], NULL);
+
+	for (iterator_worker = 0; iterator_worker < pool->number_of_threads; iterator_worker++)
+		pthread_mutex_destroy(&pool->queues[iterator_worker].lock);
+
+	pthread_mutex_destroy(&pool->lock);
+	pthread_cond_destroy(&pool->round_started);
+	pthread_cond_destroy(&pool->round_finished);
+	free(pool->threads);
+	free(pool->queues);
+	free(pool);
+}
+
+/* number_of_processors: number of processors online
+ * returns: number of processors, at least 1
+*/
+int number_of_processors(void)
+{
+	long processors = sysconf(_SC_NPROCESSORS_ONLN);
+
+	return processors > 0 ? (int) processors : 1;
+}
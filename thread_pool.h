@@ -0,0 +1,61 @@
+/*
+ * thread_pool.h: Virtual Machine Placement with OverSubscription Problem - Thread Pool Header
+ * Date: 17-10-2026
+ *
+ * A fixed group of worker threads runs a task over the items 0..n-1 of a round, for example
+ * the individuals of a population. The items are divided in chunks and every worker starts with
+ * an equal part of them in its own queue. A worker that empties its queue steals half of the
+ * chunks left in the queue of another worker, so individuals with a long local search do not
+ * keep the other workers idle. The calling thread works too, as worker 0.
+*/
+
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+/* include libraries */
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+
+/* chunks per worker at the beginning of a round, more chunks balance better but lock more */
+#define THREAD_POOL_CHUNKS_PER_WORKER 8
+
+/* task of a round: processes one item, the worker identifies the thread that runs it */
+typedef void (*thread_pool_task)(void *data, int item, int worker);
+
+/* queue of a worker: the chunks first..last-1 of the round are still to be processed */
+struct thread_pool_queue
+{
+	pthread_mutex_t lock;
+	int first;
+	int last;
+};
+
+struct thread_pool
+{
+	int number_of_threads;
+	pthread_t *threads;
+	struct thread_pool_queue *queues;
+
+	/* the round: task, data and chunks of items */
+	thread_pool_task task;
+	void *data;
+	int number_of_items;
+	int chunk_size;
+
+	/* the workers wait for a new round and the caller waits for the workers that are still working */
+	pthread_mutex_t lock;
+	pthread_cond_t round_started;
+	pthread_cond_t round_finished;
+	int round;
+	int working;
+	int stop;
+};
+
+/* function headers definitions */
+struct thread_pool *thread_pool_create(int number_of_threads);
+void thread_pool_run(struct thread_pool *pool, int number_of_items, thread_pool_task task, void *data);
+void thread_pool_free(struct thread_pool *pool);
+int number_of_processors(void);
+
+#endif
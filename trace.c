@@ -0,0 +1,156 @@
+/*
+ * trace.c: Virtual Machine Placement with OverSubscription Problem - Timeline Trace
+ * Date: 17-10-2026
+ *
+ * The events are kept in memory and written between the generations, when the workers are
+ * idle, so a lap only takes a lock and copies an event. Each thread gets a number at its
+ * first event, the tid of its row in the timeline.
+*/
+
+/* include timeline trace header */
+#include "trace.h"
+
+#ifdef VMPOS_PROFILE
+
+#include <stdlib.h>
+
+/* number of the last thread that added an event, and number of the thread */
+static int trace_threads = 0;
+static _Thread_local int trace_thread = 0;
+
+/* nanoseconds_since: nanoseconds from the beginning of the trace to a moment of the monotonic clock
+ * parameter: trace
+ * parameter: moment
+ * returns: nanoseconds
+*/
+static unsigned long long nanoseconds_since(struct trace *trace, struct timespec *moment)
+{
+	return (unsigned long long) ((long long) (moment->tv_sec - trace->start.tv_sec) * 1000000000LL + (moment->tv_nsec - trace->start.tv_nsec));
+}
+
+/* trace_open: creates a trace and its file
+ * parameter: path of the file, it is overwritten
+ * parameter: beginning of the trace, the time zero of the timeline
+ * returns: trace, NULL if the file could not be created
+*/
+struct trace *trace_open(const char *path, struct timespec *start)
+{
+	struct trace *trace;
+	FILE *file = fopen(path, "w");
+
+	if (file == NULL)
+	{
+		printf("\n[WARNING]: Could not create the trace file %s.\n", path);
+		return NULL;
+	}
+
+	trace = (struct trace *) malloc (sizeof (struct trace));
+
+	if (trace == NULL)
+	{
+		printf ("[ERROR]: Problem with memory space. Function malloc returned NULL!\n");
+		exit (EXIT_FAILURE);
+	}
+
+	trace->file = file;
+	trace->start = *start;
+	pthread_mutex_init(&trace->lock, NULL);
+	trace->events = NULL;
+	trace->size = 0;
+	trace->capacity = 0;
+	trace->written = 0;
+
+	fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+	fprintf(file, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"vmpos\"}}");
+	trace->written = 1;
+
+	return trace;
+}
+
+/* trace_event: adds an event to the trace, in the row of the calling thread
+ * parameter: trace
+ * parameter: name of the event, a constant string
+ * parameter: generation of the event, or -1 for an event of a stage
+ * parameter: begin of the event
+ * parameter: end of the event
+ * returns: nothing, it's void
+*/
+void trace_event(struct trace *trace, const char *name, int generation, struct timespec *begin, struct timespec *end)
+{
+	struct trace_event *event;
+
+	if (trace_thread == 0)
+		trace_thread = __atomic_add_fetch(&trace_threads, 1, __ATOMIC_RELAXED);
+
+	pthread_mutex_lock(&trace->lock);
+
+	if (trace->size == trace->capacity)
+	{
+		trace->capacity = trace->capacity > 0 ? 2 * trace->capacity : 1024;
+		trace->events = (struct trace_event *) realloc (trace->events, trace->capacity * sizeof (struct trace_event));
+
+		if (trace->events == NULL)
+		{
+			printf ("[ERROR]: Problem with memory space. Function realloc returned NULL!\n");
+			exit (EXIT_FAILURE);
+		}
+	}
+
+	event = &trace->events[trace->size++];
+	event->name = name;
+	event->generation = generation;
+	event->thread = trace_thread;
+	event->begin = nanoseconds_since(trace, begin);
+	event->duration = nanoseconds_since(trace, end) - event->begin;
+
+	pthread_mutex_unlock(&trace->lock);
+}
+
+/* trace_flush: writes the events kept in memory in the file of the trace
+ * parameter: trace
+ * returns: nothing, it's void
+*/
+void trace_flush(struct trace *trace)
+{
+	int iterator_event;
+	struct trace_event *event;
+
+	pthread_mutex_lock(&trace->lock);
+
+	/* the times of the format are microseconds */
+	for (iterator_event = 0; iterator_event < trace->size; iterator_event++)
+	{
+		event = &trace->events[iterator_event];
+
+		fprintf(trace->file, "%s{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f", trace->written > 0 ? ",\n" : "",
+			event->name, event->thread, event->begin / 1e3, event->duration / 1e3);
+
+		if (event->generation >= 0)
+			fprintf(trace->file, ",\"args\":{\"generation\":%d}", event->generation);
+
+		fprintf(trace->file, "}");
+		trace->written++;
+	}
+
+	trace->size = 0;
+
+	pthread_mutex_unlock(&trace->lock);
+}
+
+/* trace_close: writes the events left, ends the file and frees the trace
+ * parameter: trace
+ * returns: nothing, it's void
+*/
+void trace_close(struct trace *trace)
+{
+	trace_flush(trace);
+
+	fprintf(trace->file, "\n]}\n");
+	fclose(trace->file);
+
+	pthread_mutex_destroy(&trace->lock);
+	free(trace->events);
+	free(trace);
+}
+
+#endif
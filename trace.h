@@ -0,0 +1,50 @@
+/*
+ * trace.h: Virtual Machine Placement with OverSubscription Problem - Timeline Trace Header
+ * Date: 17-10-2026
+ *
+ * The trace writes the laps of the stage profiler as a timeline in the Chrome Trace Event
+ * format, that chrome://tracing and ui.perfetto.dev open. Every lap is a complete event, with
+ * its begin and its duration, in the row of the thread that ran it, and every generation is an
+ * event in the row of the thread of the solve. It is compiled with the profiler, only with
+ * -DVMPOS_PROFILE, and it is turned on for a solve with the trace_path of the context.
+*/
+
+#ifndef TRACE_H
+#define TRACE_H
+
+/* include libraries */
+#include <stdio.h>
+#include <time.h>
+#include <pthread.h>
+
+/* an event of the timeline, the times in nanoseconds since the beginning of the trace */
+struct trace_event
+{
+	const char *name;
+	int generation;
+	int thread;
+	unsigned long long begin;
+	unsigned long long duration;
+};
+
+/* structure of a trace */
+struct trace
+{
+	FILE *file;
+	struct timespec start;
+	/* events not yet written, the workers of the thread pool add them at the same time */
+	pthread_mutex_t lock;
+	struct trace_event *events;
+	int size;
+	int capacity;
+	/* events written in the file, to separate them with commas */
+	unsigned long long written;
+};
+
+/* function headers definitions */
+struct trace *trace_open(const char *path, struct timespec *start);
+void trace_event(struct trace *trace, const char *name, int generation, struct timespec *begin, struct timespec *end);
+void trace_flush(struct trace *trace);
+void trace_close(struct trace *trace);
+
+#endif
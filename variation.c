@@ -17,122 +17,382 @@
 #include <stdlib.h>
 #include <math.h>
 #include <time.h>
+#include <limits.h>
 
 #include "variation.h"
 #include "common.h"
+#include "evaluation.h"
+#include "dominance.h"
+
+/* point of the divide and conquer sorting: objective functions of a solution */
+struct sorting_point
+{
+	float objective[3];
+	int solution;
+};
+
+/* event of a merge of the divide and conquer sorting: a point of the left half updates the tree, one of the right half queries it */
+struct sorting_event
+{
+	float objective;
+	int rank;
+	int point;
+	int query;
+};
 
 /* non_dominated_sorting: calculate fitness according to NSGA-II
  * parameter: solutions matrix
  * parameter: number of individuals
+ * parameter: arena to take the array from, or NULL to use malloc
  * returns: array with the Pareto front
 */
-int *non_dominated_sorting(float **solutions, int number_of_individuals)
+int *non_dominated_sorting(float **solutions, int number_of_individuals, struct arena *arena)
+{
+	/* the quadratic sorting is faster for small populations */
+	if (number_of_individuals < DIVIDE_AND_CONQUER_SORTING_MINIMUM)
+		return fast_non_dominated_sorting(solutions, number_of_individuals, arena);
+
+	return divide_and_conquer_sorting(solutions, number_of_individuals, arena);
+}
+
+/* fast_non_dominated_sorting: calculate the Pareto fronts with the fast non-dominated sorting of Deb et al., O(N^2)
+ * parameter: solutions matrix
+ * parameter: number of individuals
+ * parameter: arena to take the array from, or NULL to use malloc
+ * returns: array with the Pareto front
+*/
+int *fast_non_dominated_sorting(float **solutions, int number_of_individuals, struct arena *arena)
 {
 	/* iterators */
 	int iterator_solution = 0;
 	int iterator_comparision = 0;
-	/* Pareto front identificator initializated to 1 */
-	int actual_pareto_front = 1;
+	size_t iterator_word;
+	unsigned int word;
 
-	/* Pareto fronts array */
-	int *pareto_fronts = (int *) malloc (number_of_individuals *sizeof (int));
+	/* words of 32 bits per row of the domination matrix */
+	size_t row_words = ((size_t) number_of_individuals + 31) / 32;
 
-	if (pareto_fronts == NULL)
+	/* Pareto fronts array */
+	int *pareto_fronts = (int *) arena_alloc (arena, number_of_individuals *sizeof (int));
+	/* number of solutions that dominate each solution */
+	int *domination_count = (int *) arena_alloc (arena, number_of_individuals *sizeof (int));
+	/* solutions in order of Pareto front, the ones of the actual front are taken from the head */
+	int *sorted_solutions = (int *) arena_alloc (arena, number_of_individuals *sizeof (int));
+	int head = 0, tail = 0;
+	/* domination matrix: bit b of row a is set if the solution a dominates the solution b */
+	unsigned int *dominated = (unsigned int *) arena_alloc (arena, (row_words * number_of_individuals + 1) *sizeof (unsigned int));
+	/* objective functions by columns for the dominance kernel, and dominance of a solution with the following ones */
+	float *objectives = (float *) arena_alloc (arena, ((size_t) number_of_individuals * 3 + 1) *sizeof (float));
+	float *objective_0 = objectives;
+	float *objective_1 = objectives + number_of_individuals;
+	float *objective_2 = objectives + 2 * (size_t) number_of_individuals;
+	signed char *dominance_results = (signed char *) arena_alloc (arena, number_of_individuals + 1);
+
+	memset(domination_count, 0, number_of_individuals *sizeof (int));
+	memset(dominated, 0, row_words * number_of_individuals *sizeof (unsigned int));
+
+	for (iterator_solution = 0; iterator_solution < number_of_individuals; iterator_solution++)
 	{
-		printf ("[ERROR]: Problem with memory space. Function malloc returned NULL!\n");
-    exit (EXIT_FAILURE);
+		objective_0[iterator_solution] = solutions[iterator_solution][0];
+		objective_1[iterator_solution] = solutions[iterator_solution][1];
+		objective_2[iterator_solution] = solutions[iterator_solution][2];
 	}
 
-	/* Pareto fronts initializated to 0 */
-	for (iterator_solution=0; iterator_solution < number_of_individuals; iterator_solution++)
+	/* every pair of solutions is compared once, a solution with the block of the following ones */
+	for (iterator_solution = 0; iterator_solution < number_of_individuals; iterator_solution++)
 	{
-		pareto_fronts[iterator_solution] = 0;
+		dominance_batch(solutions[iterator_solution], objective_0 + iterator_solution + 1, objective_1 + iterator_solution + 1, objective_2 + iterator_solution + 1,
+			number_of_individuals - iterator_solution - 1, dominance_results + iterator_solution + 1);
+
+		for (iterator_comparision = iterator_solution + 1; iterator_comparision < number_of_individuals; iterator_comparision++)
+		{
+			if (dominance_results[iterator_comparision] == 0)
+				continue;
+
+			if (dominance_results[iterator_comparision] == 1)
+			{
+				dominated[iterator_solution * row_words + iterator_comparision / 32] |= 1u << (iterator_comparision % 32);
+				domination_count[iterator_comparision]++;
+			}
+			else
+			{
+				dominated[iterator_comparision * row_words + iterator_solution / 32] |= 1u << (iterator_solution % 32);
+				domination_count[iterator_solution]++;
+			}
+		}
 	}
 
-	/* auxiliar integers */
-	int dominance;
-	int dont_add;
-	int allocated_solutions=0;
+	/* the solutions not dominated by any other are the first Pareto front */
+	for (iterator_solution = 0; iterator_solution < number_of_individuals; iterator_solution++)
+	{
+		if (domination_count[iterator_solution] == 0)
+		{
+			pareto_fronts[iterator_solution] = 1;
+			sorted_solutions[tail++] = iterator_solution;
+		}
+	}
 
-	/* while all the solutions have been evaluated */
-	while (allocated_solutions < number_of_individuals)
+	/* a solution goes to the front after the last one of the solutions that dominate it */
+	while (head < tail)
 	{
-		/* iterate on solutions */
-		for (iterator_solution=0; iterator_solution < number_of_individuals; iterator_solution++)
+		iterator_solution = sorted_solutions[head++];
+
+		for (iterator_word = 0; iterator_word < row_words; iterator_word++)
 		{
-			/* flag for a solution to be added */
-			dont_add = 0;
-			/* compare with the actual Pareto front */
-			if (pareto_fronts[iterator_solution]==0)
+			word = dominated[iterator_solution * row_words + iterator_word];
+
+			while (word != 0)
 			{
-				for (iterator_comparision=0; iterator_comparision < number_of_individuals; iterator_comparision++)
-				{
-					/* if the solution is not itself, it is not been evaluated or is in the actual Pareto front */
-					if (iterator_solution != iterator_comparision && pareto_fronts[iterator_comparision]==0 || pareto_fronts[iterator_comparision]==actual_pareto_front)
-					{
-						/* verificate the dominance between both*/
-						dominance = is_dominated(solutions,iterator_solution,iterator_comparision);
-						/* is dominated by a solution that is in the Pareto front, so this solution is not added*/
-						if (dominance == -1)
-						{
-							dont_add = 1;
-							break;
-						}
-					}
-				}	
-				/* if the solution is not dominated by any other, let's add it to the actual Pareto front */
-				if (dont_add == 0)
+				iterator_comparision = iterator_word * 32 + __builtin_ctz(word);
+				word &= word - 1;
+
+				if (--domination_count[iterator_comparision] == 0)
 				{
-					pareto_fronts[iterator_solution] = actual_pareto_front;
-					allocated_solutions++;
+					pareto_fronts[iterator_comparision] = pareto_fronts[iterator_solution] + 1;
+					sorted_solutions[tail++] = iterator_comparision;
 				}
 			}
 		}
-		actual_pareto_front++;
 	}
+
+	if (arena == NULL)
+	{
+		free(domination_count);
+		free(sorted_solutions);
+		free(dominated);
+		free(objectives);
+		free(dominance_results);
+	}
+
 	return pareto_fronts;
 }
 
-/* is_dominated: usual non-domination checking
- * parameter: solutions matrix
- * parameter: identificator of the individual a
- * parameter: identificator of the individual b
- * returns: 1 if a dominates b, -1 if b dominates a, 0 if both a and b are non-dominated 
+/* compare_points: lexicographic order of the objective functions, qsort comparator
+ * parameter: points to compare
+ * returns: negative, 0 or positive
 */
-int is_dominated(float **solutions, int a, int b)
+static int compare_points(const void *a, const void *b)
 {
-	/* if a dominates b */
-	/* a better in all objectives */
-	if(solutions[a][0] < solutions[b][0] && solutions[a][1] < solutions[b][1] && solutions[a][2] < solutions[b][2] || 
-	/* a better or equal in one objective and better in the others */
-	solutions[a][0] <= solutions[b][0] && solutions[a][1] < solutions[b][1] && solutions[a][2] < solutions[b][2] ||
-	solutions[a][0] < solutions[b][0] && solutions[a][1] <= solutions[b][1] && solutions[a][2] < solutions[b][2] ||
-	solutions[a][0] < solutions[b][0] && solutions[a][1] < solutions[b][1] && solutions[a][2] <= solutions[b][2] ||
-	/* a better or equal in two objectives and better in the other */
-	solutions[a][0] <= solutions[b][0] && solutions[a][1] <= solutions[b][1] && solutions[a][2] < solutions[b][2] ||
-	solutions[a][0] <= solutions[b][0] && solutions[a][1] < solutions[b][1] && solutions[a][2] <= solutions[b][2] ||
-	solutions[a][0] < solutions[b][0] && solutions[a][1] <= solutions[b][1] && solutions[a][2] <= solutions[b][2] )
+	const struct sorting_point *point_a = (const struct sorting_point *) a;
+	const struct sorting_point *point_b = (const struct sorting_point *) b;
+	int iterator_objective;
+
+	for (iterator_objective = 0; iterator_objective < 3; iterator_objective++)
 	{
+		if (point_a->objective[iterator_objective] < point_b->objective[iterator_objective])
+			return -1;
+		if (point_a->objective[iterator_objective] > point_b->objective[iterator_objective])
+			return 1;
+	}
+	return point_a->solution - point_b->solution;
+}
+
+/* compare_values: increasing order of floats, qsort comparator
+ * parameter: values to compare
+ * returns: negative, 0 or positive
+*/
+static int compare_values(const void *a, const void *b)
+{
+	float value_a = *(const float *) a;
+	float value_b = *(const float *) b;
+
+	return (value_a > value_b) - (value_a < value_b);
+}
+
+/* compare_events: order of the second objective function, with the updates before the queries of the same value, qsort comparator
+ * parameter: events to compare
+ * returns: negative, 0 or positive
+*/
+static int compare_events(const void *a, const void *b)
+{
+	const struct sorting_event *event_a = (const struct sorting_event *) a;
+	const struct sorting_event *event_b = (const struct sorting_event *) b;
+
+	if (event_a->objective < event_b->objective)
+		return -1;
+	if (event_a->objective > event_b->objective)
 		return 1;
+	if (event_a->query != event_b->query)
+		return event_a->query - event_b->query;
+	return event_a->point - event_b->point;
+}
+
+/* sort_fronts: assigns the fronts of the points from low to high, in lexicographic order.
+ * The front of a point is 1 + the biggest front of the points that dominate it, that are the points before it
+ * with the second and third objective functions lower or equal. The fronts of the left half are final before
+ * they are passed to the right half, with a sweep on the second objective and a Fenwick tree of maximums on the
+ * rank of the third one
+ * parameter: points sorted, without repetitions
+ * parameter: ranks of the third objective function of the points, from 1
+ * parameter: fronts of the points
+ * parameter: Fenwick tree, with all its values to 0
+ * parameter: size of the tree
+ * parameter: events array
+ * parameter: first point
+ * parameter: last point
+ * returns: nothing, it's void
+*/
+static void sort_fronts(struct sorting_point *points, int *ranks, int *fronts, int *tree, int tree_size, struct sorting_event *events, int low, int high)
+{
+	int middle = low + (high - low) / 2;
+	int iterator_point, iterator_event, number_of_events = 0;
+	int index, best;
+
+	if (low >= high)
+		return;
+
+	sort_fronts(points, ranks, fronts, tree, tree_size, events, low, middle);
+
+	for (iterator_point = low; iterator_point <= high; iterator_point++)
+	{
+		events[number_of_events].objective = points[iterator_point].objective[1];
+		events[number_of_events].rank = ranks[iterator_point];
+		events[number_of_events].point = iterator_point;
+		events[number_of_events].query = (iterator_point > middle);
+		number_of_events++;
 	}
 
-	/* if b dominates a */
-	/* b better in all objectives */
-	if(solutions[b][0] < solutions[a][0] && solutions[b][1] < solutions[a][1] && solutions[b][2] < solutions[a][2] || 
-	/* b better or equal in one objective and better in the others */
-	solutions[b][0] <= solutions[a][0] && solutions[b][1] < solutions[a][1] && solutions[b][2] < solutions[a][2] ||
-	solutions[b][0] < solutions[a][0] && solutions[b][1] <= solutions[a][1] && solutions[b][2] < solutions[a][2] ||
-	solutions[b][0] < solutions[a][0] && solutions[b][1] < solutions[a][1] && solutions[b][2] <= solutions[a][2] ||
-	/* b better or equal in two objectives and better in the other */
-	solutions[b][0] <= solutions[a][0] && solutions[b][1] <= solutions[a][1] && solutions[b][2] < solutions[a][2] ||
-	solutions[b][0] <= solutions[a][0] && solutions[b][1] < solutions[a][1] && solutions[b][2] <= solutions[a][2] ||
-	solutions[b][0] < solutions[a][0] && solutions[b][1] <= solutions[a][1] && solutions[b][2] <= solutions[a][2] )
+	qsort(events, number_of_events, sizeof (struct sorting_event), compare_events);
+
+	for (iterator_event = 0; iterator_event < number_of_events; iterator_event++)
 	{
-		return -1;
+		if (!events[iterator_event].query)
+		{
+			/* the front of a left point is available for the points with a bigger or equal rank */
+			for (index = events[iterator_event].rank; index <= tree_size; index += index & -index)
+				if (tree[index] < fronts[events[iterator_event].point])
+					tree[index] = fronts[events[iterator_event].point];
+		}
+		else
+		{
+			/* biggest front of the left points with a lower or equal rank */
+			best = 0;
+			for (index = events[iterator_event].rank; index > 0; index -= index & -index)
+				if (tree[index] > best)
+					best = tree[index];
+
+			if (best + 1 > fronts[events[iterator_event].point])
+				fronts[events[iterator_event].point] = best + 1;
+		}
+	}
+
+	/* clean the tree for the next merge */
+	for (iterator_event = 0; iterator_event < number_of_events; iterator_event++)
+		if (!events[iterator_event].query)
+			for (index = events[iterator_event].rank; index <= tree_size && tree[index] != 0; index += index & -index)
+				tree[index] = 0;
+
+	sort_fronts(points, ranks, fronts, tree, tree_size, events, middle + 1, high);
+}
+
+/* divide_and_conquer_sorting: calculate the Pareto fronts of 3 objective functions by divide and conquer, O(N log^2 N)
+ * parameter: solutions matrix
+ * parameter: number of individuals
+ * parameter: arena to take the array from, or NULL to use malloc
+ * returns: array with the Pareto front, the same of fast_non_dominated_sorting
+*/
+int *divide_and_conquer_sorting(float **solutions, int number_of_individuals, struct arena *arena)
+{
+	/* iterators */
+	int iterator_solution;
+	int number_of_points = 0;
+	int number_of_values = 0;
+	int low, high, middle;
+
+	int *pareto_fronts;
+	struct sorting_point *points;
+	struct sorting_event *events;
+	float *values;
+	int *ranks, *fronts, *tree;
+
+	/* NaN has no order, these objective functions are sorted by pairs */
+	for (iterator_solution = 0; iterator_solution < number_of_individuals; iterator_solution++)
+		if (isnan(solutions[iterator_solution][0]) || isnan(solutions[iterator_solution][1]) || isnan(solutions[iterator_solution][2]))
+			return fast_non_dominated_sorting(solutions, number_of_individuals, arena);
+
+	pareto_fronts = (int *) arena_alloc (arena, number_of_individuals *sizeof (int));
+	points = (struct sorting_point *) arena_alloc (arena, number_of_individuals *sizeof (struct sorting_point));
+	events = (struct sorting_event *) arena_alloc (arena, number_of_individuals *sizeof (struct sorting_event));
+	values = (float *) arena_alloc (arena, number_of_individuals *sizeof (float));
+	ranks = (int *) arena_alloc (arena, number_of_individuals *sizeof (int));
+	fronts = (int *) arena_alloc (arena, number_of_individuals *sizeof (int));
+	tree = (int *) arena_alloc (arena, (number_of_individuals + 1) *sizeof (int));
+
+	for (iterator_solution = 0; iterator_solution < number_of_individuals; iterator_solution++)
+	{
+		memcpy(points[iterator_solution].objective, solutions[iterator_solution], 3 * sizeof (float));
+		points[iterator_solution].solution = iterator_solution;
+	}
+
+	qsort(points, number_of_individuals, sizeof (struct sorting_point), compare_points);
+
+	/* repeated solutions do not dominate each other: they are sorted once, at the position of the first one */
+	for (iterator_solution = 0; iterator_solution < number_of_individuals; iterator_solution++)
+	{
+		if (number_of_points == 0 || points[number_of_points - 1].objective[0] != points[iterator_solution].objective[0] ||
+			points[number_of_points - 1].objective[1] != points[iterator_solution].objective[1] ||
+			points[number_of_points - 1].objective[2] != points[iterator_solution].objective[2])
+			points[number_of_points++] = points[iterator_solution];
+
+		/* the front of the solution is the front of the point, number_of_points - 1 */
+		pareto_fronts[points[iterator_solution].solution] = number_of_points - 1;
+	}
+
+	/* ranks of the third objective function */
+	for (iterator_solution = 0; iterator_solution < number_of_points; iterator_solution++)
+		values[iterator_solution] = points[iterator_solution].objective[2];
+
+	qsort(values, number_of_points, sizeof (float), compare_values);
+
+	for (iterator_solution = 0; iterator_solution < number_of_points; iterator_solution++)
+		if (number_of_values == 0 || values[number_of_values - 1] != values[iterator_solution])
+			values[number_of_values++] = values[iterator_solution];
+
+	for (iterator_solution = 0; iterator_solution < number_of_points; iterator_solution++)
+	{
+		low = 0;
+		high = number_of_values - 1;
+		while (low < high)
+		{
+			middle = low + (high - low) / 2;
+			if (values[middle] < points[iterator_solution].objective[2])
+				low = middle + 1;
+			else
+				high = middle;
+		}
+		ranks[iterator_solution] = low + 1;
+		fronts[iterator_solution] = 1;
 	}
 
-	/* if comes here, both are non-dominated */
-	return 0;
+	memset(tree, 0, (number_of_individuals + 1) *sizeof (int));
+
+	sort_fronts(points, ranks, fronts, tree, number_of_values, events, 0, number_of_points - 1);
+
+	for (iterator_solution = 0; iterator_solution < number_of_individuals; iterator_solution++)
+		pareto_fronts[iterator_solution] = fronts[pareto_fronts[iterator_solution]];
+
+	if (arena == NULL)
+	{
+		free(points);
+		free(events);
+		free(values);
+		free(ranks);
+		free(fronts);
+		free(tree);
+	}
+
+	return pareto_fronts;
+}
+
+/* is_dominated: usual non-domination checking, with the dominance kernel
+ * parameter: solutions matrix
+ * parameter: identificator of the individual a
+ * parameter: identificator of the individual b
+ * returns: 1 if a dominates b, -1 if b dominates a, 0 if both a and b are non-dominated 
+*/
+int is_dominated(float **solutions, int a, int b)
+{
+	return dominance(solutions[a], solutions[b]);
 }
 
 
@@ -140,9 +400,10 @@ int is_dominated(float **solutions, int a, int b)
  * parameter: array of the Pareto front
  * parameter: number of individuals
  * parameter: number of selection percent
+ * parameter: random number stream
  * returns: the parent for the crossover
 */
-int selection(int *fronts, int number_of_individuals, float percent)
+int selection(int *fronts, int number_of_individuals, float percent, struct rng *rng)
 {
 	/* iterator */
 	int iterator_solution;
@@ -150,12 +411,12 @@ int selection(int *fronts, int number_of_individuals, float percent)
 	int posible_parent;
 
 	/* generate randomically a parent candidate */
-	actual_parent = rand() % (number_of_individuals);
+	actual_parent = rng_bounded(rng, number_of_individuals);
 
 	/* iterate on positions of an individual and select the parents for the crossover */
 	for (iterator_solution=0; iterator_solution < (number_of_individuals * percent); iterator_solution++)
 	{
-		posible_parent = rand() % (number_of_individuals);
+		posible_parent = rng_bounded(rng, number_of_individuals);
 		if (fronts[actual_parent] > fronts[posible_parent])
 			actual_parent = posible_parent;
 	}
@@ -164,16 +425,19 @@ int selection(int *fronts, int number_of_individuals, float percent)
 }
 
 /* crossover: performs the crossover operation
- * parameter: population matrix
+ * parameter: population
  * parameter: the mother for the crossover
  * parameter: the father for the crossover
  * parameter: number of virtual machines
  * returns: nothing, it's void
 */
-void crossover(int **population, int position_parent1, int position_parent2, int v_size)
+void crossover(struct population *population, int position_parent1, int position_parent2, int v_size)
 {
   /* iterators */
 	int iterator_virtual;
+	/* genes of the parents */
+	int *parent1 = INDIVIDUAL(population, position_parent1);
+	int *parent2 = INDIVIDUAL(population, position_parent2);
 	/* auxiliary parameter */
 	int aux;
 	/* iterate on virtual machines and performs the crossing */
@@ -184,148 +448,179 @@ void crossover(int **population, int position_parent1, int position_parent2, int
 		{
 			if (iterator_virtual < v_size / 2)
 			{
-				population[position_parent1][iterator_virtual] = population[position_parent1][iterator_virtual];
-				population[position_parent2][iterator_virtual] = population[position_parent2][iterator_virtual];
+				parent1[iterator_virtual] = parent1[iterator_virtual];
+				parent2[iterator_virtual] = parent2[iterator_virtual];
 			}
 			else
 			{
-				aux = population[position_parent2][iterator_virtual];
-				population[position_parent2][iterator_virtual] = population[position_parent1][iterator_virtual];
-				population[position_parent1][iterator_virtual] = aux;
+				aux = parent2[iterator_virtual];
+				parent2[iterator_virtual] = parent1[iterator_virtual];
+				parent1[iterator_virtual] = aux;
 			}
 		} 
 		else
 		{
 			if (iterator_virtual < (v_size / 2) + 1)
 			{
-				population[position_parent1][iterator_virtual] = population[position_parent1][iterator_virtual];
-				population[position_parent2][iterator_virtual] = population[position_parent2][iterator_virtual];
+				parent1[iterator_virtual] = parent1[iterator_virtual];
+				parent2[iterator_virtual] = parent2[iterator_virtual];
 			}
 			else
 			{
-				aux = population[position_parent2][iterator_virtual];
-				population[position_parent2][iterator_virtual] = population[position_parent1][iterator_virtual];
-				population[position_parent1][iterator_virtual] = aux;
+				aux = parent2[iterator_virtual];
+				parent2[iterator_virtual] = parent1[iterator_virtual];
+				parent1[iterator_virtual] = aux;
 			}
 		}
 	}
 }
 
 /* mutation: performs the mutation operation
- * parameter: population matrix
+ * parameter: solver context
+ * parameter: population, with its utilization and evaluation loaded
+ * parameter: commitment matrix
+ * parameter: physical machines matrix
+ * parameter: virtual machines matrix
+ * parameter: number of physical machines usable by each individual
  * parameter: number of individuals
  * parameter: number of physical machines
  * parameter: number of virtual machines
+ * parameter: random number stream of each individual
+ * returns: nothing, it's void
+*/
+void mutation(struct vmpos_context *context, struct population *population, float **cm, int **H, int **V, int *h_sizes, int number_of_individuals, int h_size, int v_size, int CRITICAL_SERVICES, struct rng *streams)
+{
+	int iterator_individual;
+
+	/* iterate on individuals */
+	for (iterator_individual = 0 ; iterator_individual < number_of_individuals ; iterator_individual++)
+		mutate_individual(context, population, cm, H, V, h_sizes, v_size, CRITICAL_SERVICES, iterator_individual, &streams[iterator_individual]);
+}
+
+/* geometric_skip: number of virtual machines not mutated before the next mutated one. With a mutation rate p for each
+ * virtual machine, the number follows a geometric distribution: floor(log(U) / log(1 - p)), U uniform in (0, 1]
+ * parameter: random number stream
+ * parameter: log(1 - p)
+ * returns: number of virtual machines to skip
+*/
+static int geometric_skip(struct rng *rng, double log_complement)
+{
+	double skip;
+
+	/* mutation rate of 1, every virtual machine is mutated */
+	if (isinf(log_complement))
+		return 0;
+
+	skip = floor(log(1.0 - rng_uniform(rng)) / log_complement);
+
+	return skip < INT_MAX / 2 ? (int) skip : INT_MAX / 2;
+}
+
+/* mutate_individual: performs the mutation operation on one individual, it only changes the state of this individual.
+ * Each virtual machine is mutated with the mutation rate of the context, and only the mutated ones draw random numbers
+ * parameter: solver context
+ * parameter: population, with its utilization and evaluation loaded
+ * parameter: commitment matrix
+ * parameter: physical machines matrix
+ * parameter: virtual machines matrix
+ * parameter: number of physical machines usable by each individual
+ * parameter: number of virtual machines
+ * parameter: identificator of the individual to mutate
+ * parameter: random number stream of the individual
  * returns: nothing, it's void
 */
-void mutation(int **population, int **V, int number_of_individuals, int h_size, int v_size)
+void mutate_individual(struct vmpos_context *context, struct population *population, float **cm, int **H, int **V, int *h_sizes, int v_size, int CRITICAL_SERVICES, int iterator_individual, struct rng *rng)
 {
    	/* iterators */
 	int iterator_virtual;
 	int physical_position;
-	int iterator_individual;
+	int *individual = INDIVIDUAL(population, iterator_individual);
 
 	/* auxiliary parameter */
 	int aux;
-	float probability;
+	double log_complement;
 
-	srand48(time(NULL));
-	h_size + 1;
+	/* in average one virtual machine is mutated in each individual if the rate is not configured */
+	float mutation_rate = context->mutation_rate > 0.0 ? context->mutation_rate : 1.0 / v_size;
 
-	/* iterate on individuals */
-	for (iterator_individual = 0 ; iterator_individual < number_of_individuals ; iterator_individual++)
+	log_complement = mutation_rate < 1.0 ? log1p(-mutation_rate) : -INFINITY;
+
+	/* iterate on the mutated virtual machines, jumping over the ones that are not mutated */
+	for (iterator_virtual = geometric_skip(rng, log_complement) ; iterator_virtual < v_size ; iterator_virtual += 1 + geometric_skip(rng, log_complement))
 	{
-		/* iterate on virtual machines */
-		for (iterator_virtual = 0 ; iterator_virtual < v_size ; iterator_virtual++)
+		/* get the position of the physical machine the random */
+		if (V[3][iterator_virtual] == 1)
+		{
+			physical_position = rng_bounded(rng, h_sizes[iterator_individual]) + 1;
+		}
+		else 
 		{
-			probability = drand48() *1.0;
-			/* if the probablidad is less than 1/v_size, performs the mutation */
-			if (probability < (float)1/v_size)
+			physical_position = rng_bounded(rng, h_sizes[iterator_individual]);
+		}
+		/* performs the mutation operation */
+		if (physical_position != individual[iterator_virtual])
+			move_virtual_machine(context, population, cm, H, V, iterator_individual, iterator_virtual, physical_position, CRITICAL_SERVICES);
+		else
+		{
+			aux = individual[iterator_virtual];
+			while (physical_position == aux)
 			{
-				/* get the position of the physical machine the random */
-				if (V[iterator_virtual][3] == 1)
+				/* VM with critical services */
+				if (V[3][iterator_virtual] == 1)
 				{
-					physical_position = rand() % global_h_sizes[iterator_individual] + 1;
+					physical_position = rng_bounded(rng, h_sizes[iterator_individual]) + 1;
 				}
+				/* VM with NO critical services */
 				else 
 				{
-					physical_position = rand() % global_h_sizes[iterator_individual];
-				}
-				/* performs the mutation operation */
-				if (physical_position != population[iterator_individual][iterator_virtual])
-					population[iterator_individual][iterator_virtual] = physical_position;
-				else
-				{
-					aux = population[iterator_individual][iterator_virtual];
-					while (physical_position == aux)
-					{
-						/* VM with critical services */
-						if (V[iterator_virtual][3] == 1)
-						{
-							physical_position = rand() % global_h_sizes[iterator_individual] + 1;
-						}
-						/* VM with NO critical services */
-						else 
-						{
-							physical_position = rand() % global_h_sizes[iterator_individual];
-						}
-						if (physical_position != population[iterator_individual][iterator_virtual]) 
-							population[iterator_individual][iterator_virtual] = physical_position;
-					}
+					physical_position = rng_bounded(rng, h_sizes[iterator_individual]);
 				}
+				if (physical_position != individual[iterator_virtual]) 
+					move_virtual_machine(context, population, cm, H, V, iterator_individual, iterator_virtual, physical_position, CRITICAL_SERVICES);
 			}
 		}
 	}
 }
 
 /* population_evolution: update the pareto front in the population
- * parameter: population matrix
- * parameter: evolutionated population matrix
+ * parameter: population
+ * parameter: evolutionated population
  * parameter: the cost of each objetives the population matrix
  * parameter: the cost of each objetives evolutionated population matrix
  * parameter: front pareto array
  * parameter: number of individuals
  * parameter: number of virtual machines
+ * parameter: arena of the generation, for the temporaries of P union Q
  * returns: nothing, it's void
 */
-void population_evolution(int **P, int **Q, float **objectives_functions_P, float **objectives_functions_Q, int *fronts_P, int number_of_individuals, int v_size)
+void population_evolution(struct population *P, struct population *Q, float **objectives_functions_P, float **objectives_functions_Q, int *fronts_P, int number_of_individuals, int v_size, struct arena *arena)
 {
-	/* P union Q population matrix */
-	int **PQ = (int **) malloc (2 * number_of_individuals *sizeof (int *));
-	/* P union Q objectives functions values */
-	float **objectives_functions_PQ = (float **) malloc (2 * number_of_individuals *sizeof (float *));
+	/* P union Q population, stored in one block */
+	struct population *PQ = population_create(2 * number_of_individuals, v_size, arena);
+	/* P union Q objectives functions values, stored in one block */
+	float **objectives_functions_PQ = (float **) arena_alloc (arena, 2 * number_of_individuals *sizeof (float *));
+	float *objectives_functions_PQ_data = (float *) arena_alloc (arena, 2 * number_of_individuals * 3 *sizeof (float));
 	/* iterators */
 	int iterator_individual_P = 0;
 	int iterator_individual_Q = 0;
-	int iterator_individual_position = 0;
 
-	/* iterate on positions of an individual and copy the P individual and objective function */
+	/* copy the P individuals and objective functions */
 	for (iterator_individual_P=0; iterator_individual_P < number_of_individuals; iterator_individual_P++)
 	{
-		PQ[iterator_individual_P] = (int *) malloc (v_size *sizeof (int));
-		objectives_functions_PQ[iterator_individual_P] = (float *) malloc (3 *sizeof (float));
-
-		for (iterator_individual_position = 0; iterator_individual_position < v_size; iterator_individual_position++)
-		{
-			PQ[iterator_individual_P][iterator_individual_position] = P[iterator_individual_P][iterator_individual_position];
-		}
+		population_copy_individual(PQ, iterator_individual_P, P, iterator_individual_P);
 
+		objectives_functions_PQ[iterator_individual_P] = objectives_functions_PQ_data + 3 * iterator_individual_P;
 		objectives_functions_PQ[iterator_individual_P][0] = objectives_functions_P[iterator_individual_P][0];
 		objectives_functions_PQ[iterator_individual_P][1] = objectives_functions_P[iterator_individual_P][1];
 		objectives_functions_PQ[iterator_individual_P][2] = objectives_functions_P[iterator_individual_P][2];
 	}
 
-	/* iterate on positions of an individual and copy the Q individual and objective function */
+	/* copy the Q individuals and objective functions */
 	for (iterator_individual_P=number_of_individuals; iterator_individual_P < 2 * number_of_individuals; iterator_individual_P++)
 	{
-		PQ[iterator_individual_P] = (int *) malloc (v_size *sizeof (int));
-		objectives_functions_PQ[iterator_individual_P] = (float *) malloc (3 *sizeof (float));
-
-		for (iterator_individual_position = 0; iterator_individual_position < v_size; iterator_individual_position++)
-		{
-			PQ[iterator_individual_P][iterator_individual_position] = Q[iterator_individual_Q][iterator_individual_position];
-		}
+		population_copy_individual(PQ, iterator_individual_P, Q, iterator_individual_Q);
 
+		objectives_functions_PQ[iterator_individual_P] = objectives_functions_PQ_data + 3 * iterator_individual_P;
 		objectives_functions_PQ[iterator_individual_P][0] = objectives_functions_Q[iterator_individual_Q][0];
 		objectives_functions_PQ[iterator_individual_P][1] = objectives_functions_Q[iterator_individual_Q][1];
 		objectives_functions_PQ[iterator_individual_P][2] = objectives_functions_Q[iterator_individual_Q][2];
@@ -333,23 +628,15 @@ void population_evolution(int **P, int **Q, float **objectives_functions_P, floa
 	}
 
 	/* calculate fitness according to NSGA-II */
-	int *fronts_PQ = non_dominated_sorting(objectives_functions_PQ, number_of_individuals*2);
-	int *population_aux = (int *) malloc (v_size *sizeof (int));
+	int *fronts_PQ = non_dominated_sorting(objectives_functions_PQ, number_of_individuals*2, arena);
 
 	/* generate Pt+1 according to NSGA-II */
 	int iterator;
-	int iterator_virtual;
 	int iterator_P = 0;
 	int actual_pareto = 0;
 	int i,j;
 	int iterator_solution;
 
-	if (population_aux == NULL)
-	{
-		printf ("[ERROR]: Problem with memory space. Function malloc returned NULL!\n");
-    exit (EXIT_FAILURE);
-	}
-
 	/* generate Pt+1 according to NSGA-II */
 	while (iterator_P < number_of_individuals)
 	{
@@ -366,23 +653,13 @@ void population_evolution(int **P, int **Q, float **objectives_functions_P, floa
 					objectives_functions_P[iterator_P][2] = objectives_functions_PQ[iterator][2];
 					fronts_P[iterator_P] = fronts_PQ[iterator];
 								
-					for (iterator_virtual = 0; iterator_virtual<v_size ; iterator_virtual++)
-					{
-						P[iterator_P][iterator_virtual] = PQ[iterator][iterator_virtual];
-					}
+					population_copy_individual(P, iterator_P, PQ, iterator);
 					iterator_P++;
 				}
 			}
 		}
 	}
 
-	for (iterator_individual_P=0; iterator_individual_P < 2*number_of_individuals; iterator_individual_P++)
-	{
-		free (PQ[iterator_individual_P]);
-		free (objectives_functions_PQ[iterator_individual_P]);
-	}
-
-	free (PQ);
-	free (objectives_functions_PQ);
-	free (population_aux);
+	/* PQ and its objectives functions are released with the arena of the generation */
+	population_free (PQ);
 }
@@ -17,14 +17,22 @@
 #include <math.h>
 #include <time.h>
 
-extern int *global_h_sizes;
+#include "population.h"
+#include "rng.h"
+#include "context.h"
+
+/* from this number of solutions the Pareto fronts are calculated by divide and conquer, O(N log^2 N), instead of O(N^2) */
+#define DIVIDE_AND_CONQUER_SORTING_MINIMUM 256
 
 /* function headers definitions */
-int *non_dominated_sorting(float ** solutions, int number_of_individuals);
+int *non_dominated_sorting(float ** solutions, int number_of_individuals, struct arena *arena);
+int *fast_non_dominated_sorting(float ** solutions, int number_of_individuals, struct arena *arena);
+int *divide_and_conquer_sorting(float ** solutions, int number_of_individuals, struct arena *arena);
 int is_dominated(float ** solutions, int a, int b);
-int selection(int *fronts, int number_of_individuals, float percent);
-void crossover(int **population, int position_parent1, int position_parent2, int v_size);
-void mutation(int **population, int **V, int number_of_individuals, int h_size, int v_size);
-void population_evolution(int **P, int **Q, float **objectives_functions_P, float **objectives_functions_Q, int *fronts_P, int number_of_individuals, int v_size);
+int selection(int *fronts, int number_of_individuals, float percent, struct rng *rng);
+void crossover(struct population *population, int position_parent1, int position_parent2, int v_size);
+void mutation(struct vmpos_context *context, struct population *population, float **cm, int **H, int **V, int *h_sizes, int number_of_individuals, int h_size, int v_size, int CRITICAL_SERVICES, struct rng *streams);
+void mutate_individual(struct vmpos_context *context, struct population *population, float **cm, int **H, int **V, int *h_sizes, int v_size, int CRITICAL_SERVICES, int individual, struct rng *rng);
+void population_evolution(struct population *P, struct population *Q, float **objectives_functions_P, float **objectives_functions_Q, int *fronts_P, int number_of_individuals, int v_size, struct arena *arena);
 long double pareto_size();
 void update_pareto_set(int **P, float **objectives_functions_P, int *fronts_P, int number_of_individuals, int v_size);
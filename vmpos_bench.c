@@ -0,0 +1,494 @@
+/*
+ * vmpos_bench.c: Virtual Machine Placement with OverSubscription Problem - Scaling Benchmark
+ * Date: 17-10-2026
+ *
+ * Runs the VMPOS over a ladder of datacenters, from 4x8 up to 10000x50000 by default, and reports
+ * for each one the generations and the evaluations of individuals per second, the peak resident
+ * memory and the time to reach the target quality. The quality of a solution is its absolute
+ * cost, the weighted sum of its objective functions, and the target is an absolute cost given to
+ * the benchmark or read from the results of an earlier benchmark (a baseline), so a version that
+ * converges to a worse front does not reach it. The convergence time, when the best solution came
+ * within a tolerance of the final best of the same run, is reported apart. The datacenters of the
+ * ladder given as PMsxVMs are written by the generator (see generator.h) with the seed of the
+ * benchmark, so two versions of the code are compared with the same datacenters. Each datacenter
+ * runs in a child process, so the peak memory is the one of that datacenter only. The results are
+ * also appended to the file benchmark_results of the directory of the datacenters, one line per
+ * datacenter.
+*/
+
+/* include libraries */
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <sys/resource.h>
+
+/* include own headers */
+#include "common.h"
+#include "datacenter.h"
+#include "context.h"
+#include "generator.h"
+
+#define CRITICAL_SERVICES 1 //Indicates if the VM run Critical Services
+
+/* datacenters of the benchmark if no ladder is given */
+#define DEFAULT_LADDER "4x8,120x600,1000x5000,10000x50000"
+
+/* options of the benchmark */
+struct bench_options
+{
+	char *ladder;
+	char *directory;
+	char *config;
+	int individuals;
+	int generations;
+	int threads;
+	/* seconds each datacenter can run, 0 for no limit */
+	double time_limit;
+	/* distance to the target cost, and to the best cost of the run for the convergence time, in percent */
+	double tolerance;
+	/* absolute cost of the target quality of every datacenter, 0 for none */
+	double target;
+	/* results file of an earlier benchmark, with the target cost of each datacenter, NULL for none */
+	char *baseline;
+	unsigned long long seed;
+};
+
+/* best weighted cost after the first population and after every generation of a run */
+struct bench_progress
+{
+	struct timespec start;
+	double *seconds;
+	float *costs;
+	double *absolute_costs;
+	int size;
+	int capacity;
+};
+
+/* results of a datacenter, sent by the child process to the benchmark */
+struct bench_result
+{
+	int h_size;
+	int v_size;
+	int generations;
+	double seconds;
+	double evaluations;
+	float best_cost;
+	double absolute_cost;
+	/* seconds to reach the target cost, -1 if it was not reached or there is no target */
+	double time_to_target;
+	/* seconds to come within the tolerance of the best cost of the run */
+	double convergence_time;
+};
+
+/* elapsed_seconds: seconds since a moment of the monotonic clock
+ * parameter: the moment
+ * returns: seconds
+*/
+static double elapsed_seconds(struct timespec *start)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	return (double) (now.tv_sec - start->tv_sec) + (double) (now.tv_nsec - start->tv_nsec) / 1e9;
+}
+
+/* absolute_cost: weighted sum of the objective functions of the best solution of a context, not divided by the
+ * max costs of the archive like the weighted cost of the solve, so it can be compared between runs
+ * parameter: solver context
+ * returns: absolute cost
+*/
+static double absolute_cost(struct vmpos_context *context)
+{
+	return context->energy_objective_weight * context->global_best_objective_functions[0] +
+		context->dispersion_objective_weight * context->global_best_objective_functions[1] +
+		context->migration_objective_weight * context->global_best_objective_functions[2];
+}
+
+/* record_progress: keeps the best weighted and absolute costs of a generation, the generation hook of the context
+ * parameter: solver context
+ * parameter: progress of the run
+ * returns: nothing, it's void
+*/
+static void record_progress(struct vmpos_context *context, void *hook_data)
+{
+	struct bench_progress *progress = (struct bench_progress *) hook_data;
+
+	if (progress->size == progress->capacity)
+	{
+		progress->capacity = progress->capacity > 0 ? 2 * progress->capacity : 256;
+		progress->seconds = (double *) realloc (progress->seconds, progress->capacity * sizeof (double));
+		progress->costs = (float *) realloc (progress->costs, progress->capacity * sizeof (float));
+		progress->absolute_costs = (double *) realloc (progress->absolute_costs, progress->capacity * sizeof (double));
+
+		if (progress->seconds == NULL || progress->costs == NULL || progress->absolute_costs == NULL)
+		{
+			printf ("[ERROR]: Problem with memory space. Function realloc returned NULL!\n");
+			exit (EXIT_FAILURE);
+		}
+	}
+
+	progress->seconds[progress->size] = elapsed_seconds(&progress->start);
+	progress->costs[progress->size] = context->global_best_individual_cost;
+	progress->absolute_costs[progress->size] = absolute_cost(context);
+	progress->size++;
+}
+
+/* run_datacenter: solves a datacenter with the configuration of the benchmark
+ * parameter: path to the datacenter file
+ * parameter: options of the benchmark
+ * parameter: absolute cost of the target quality, 0 for none
+ * parameter: results to fill
+ * returns: 1 if the datacenter was solved, 0 if not
+*/
+static int run_datacenter(char path_to_file[], struct bench_options *options, double target_cost, struct bench_result *result)
+{
+	struct datacenter datacenter;
+	struct vmpos_context *context;
+	struct bench_progress progress;
+	float target;
+	int iterator_progress;
+
+	if (!load_datacenter(path_to_file, &datacenter, CRITICAL_SERVICES))
+		return 0;
+
+	context = vmpos_create(&datacenter, CRITICAL_SERVICES);
+
+	/* the configuration of vmpos_config.vmp, changed by the configuration file and the options */
+	context->total_of_individuals = 10;
+	context->total_of_generations = 20;
+	context->energy_objective_weight = 1.0;
+	context->dispersion_objective_weight = 1.0;
+	context->migration_objective_weight = 1.0;
+	context->cl_cs = 1.0;
+	context->cl_nc = 2.0;
+	context->mc_cs = 2.0;
+	context->mc_ncs = 1.0;
+
+	if (options->config != NULL)
+		load_dc_config(context, options->config);
+	if (options->individuals > 0)
+		context->total_of_individuals = options->individuals;
+	if (options->generations > 0)
+		context->total_of_generations = options->generations;
+	if (options->threads > 0)
+		context->number_of_threads = options->threads;
+
+	context->seed = options->seed;
+	context->time_limit = options->time_limit;
+	context->results_directory = NULL;
+
+	memset(&progress, 0, sizeof (progress));
+	context->generation_hook = record_progress;
+	context->hook_data = &progress;
+
+	clock_gettime(CLOCK_MONOTONIC, &progress.start);
+
+	if (!vmpos_solve(context))
+	{
+		vmpos_destroy(context);
+		free_datacenter(&datacenter);
+		return 0;
+	}
+
+	result->h_size = datacenter.h_size;
+	result->v_size = datacenter.v_size;
+	result->generations = context->generation;
+	result->seconds = elapsed_seconds(&progress.start);
+	/* the individuals of P_0 and of Q in every generation, in every island */
+	result->evaluations = (double) context->total_of_individuals * context->number_of_islands * (context->generation + 1);
+	result->best_cost = context->global_best_individual_cost;
+	result->absolute_cost = absolute_cost(context);
+	result->time_to_target = -1.0;
+	result->convergence_time = result->seconds;
+
+	/* the first time the absolute cost of the best solution reached the target quality */
+	if (target_cost > 0.0)
+	{
+		for (iterator_progress = 0; iterator_progress < progress.size; iterator_progress++)
+		{
+			if (progress.absolute_costs[iterator_progress] <= target_cost * (1.0 + options->tolerance / 100.0))
+			{
+				result->time_to_target = progress.seconds[iterator_progress];
+				break;
+			}
+		}
+	}
+
+	/* the first time the best cost came within the tolerance of the best cost of the run */
+	target = result->best_cost * (1.0 + options->tolerance / 100.0);
+	for (iterator_progress = 0; iterator_progress < progress.size; iterator_progress++)
+	{
+		if (progress.costs[iterator_progress] <= target)
+		{
+			result->convergence_time = progress.seconds[iterator_progress];
+			break;
+		}
+	}
+
+	free(progress.seconds);
+	free(progress.costs);
+	free(progress.absolute_costs);
+	vmpos_destroy(context);
+	free_datacenter(&datacenter);
+
+	return 1;
+}
+
+/* baseline_target: reads the target cost of a datacenter from the results file of an earlier benchmark
+ * parameter: path to the results file
+ * parameter: datacenter, like in the ladder
+ * returns: absolute cost of the last line of the datacenter in the file, 0 if there is none
+*/
+static double baseline_target(char path_to_file[], char *datacenter)
+{
+	FILE *baseline = fopen(path_to_file, "r");
+	char line[TAM_BUFFER];
+	char *field, *state;
+	int column, name_column = -1, cost_column = -1;
+	double target = 0.0, cost;
+	char *name;
+
+	if (baseline == NULL)
+		return 0.0;
+
+	/* the columns are found by their names in the first line */
+	if (fgets(line, sizeof (line), baseline) != NULL)
+	{
+		for (column = 0, field = strtok_r(line, "\t\r\n", &state); field != NULL; column++, field = strtok_r(NULL, "\t\r\n", &state))
+		{
+			if (strcmp(field, "datacenter") == 0)
+				name_column = column;
+			else if (strcmp(field, "absolute_cost") == 0)
+				cost_column = column;
+		}
+	}
+
+	while (name_column >= 0 && cost_column >= 0 && fgets(line, sizeof (line), baseline) != NULL)
+	{
+		name = NULL;
+		cost = 0.0;
+
+		for (column = 0, field = strtok_r(line, "\t\r\n", &state); field != NULL; column++, field = strtok_r(NULL, "\t\r\n", &state))
+		{
+			if (column == name_column)
+				name = field;
+			else if (column == cost_column)
+				cost = atof(field);
+		}
+
+		if (name != NULL && strcmp(name, datacenter) == 0 && cost > 0.0)
+			target = cost;
+	}
+
+	fclose(baseline);
+
+	return target;
+}
+
+/* bench_datacenter: runs a datacenter in a child process
+ * parameter: path to the datacenter file
+ * parameter: options of the benchmark
+ * parameter: absolute cost of the target quality, 0 for none
+ * parameter: results to fill
+ * parameter: peak resident memory of the child process, in kilobytes
+ * returns: 1 if the datacenter was solved, 0 if not
+*/
+static int bench_datacenter(char path_to_file[], struct bench_options *options, double target_cost, struct bench_result *result, long *peak_memory)
+{
+	int result_pipe[2];
+	int status;
+	ssize_t bytes;
+	pid_t child;
+	struct rusage usage;
+
+	if (pipe(result_pipe) != 0)
+		return 0;
+
+	/* the child does not write again what is in the buffer of the benchmark */
+	fflush(stdout);
+
+	child = fork();
+
+	if (child < 0)
+	{
+		close(result_pipe[0]);
+		close(result_pipe[1]);
+		return 0;
+	}
+
+	if (child == 0)
+	{
+		close(result_pipe[0]);
+		status = run_datacenter(path_to_file, options, target_cost, result) && write(result_pipe[1], result, sizeof (struct bench_result)) == sizeof (struct bench_result);
+		_exit(status ? 0 : 1);
+	}
+
+	close(result_pipe[1]);
+	bytes = read(result_pipe[0], result, sizeof (struct bench_result));
+	close(result_pipe[0]);
+
+	if (wait4(child, &status, 0, &usage) < 0)
+		return 0;
+
+	/* ru_maxrss is in kilobytes in Linux */
+	*peak_memory = usage.ru_maxrss;
+
+	return WIFEXITED(status) && WEXITSTATUS(status) == 0 && bytes == sizeof (struct bench_result);
+}
+
+/* main: scaling benchmark of the VMPOS
+ * parameter: optionally --ladder followed by the datacenters, PMsxVMs to generate them or paths of datacenter files,
+ *            separated by commas. --directory followed by the directory of the generated datacenters and of the results,
+ *            --config followed by a configuration file like vmpos_config.vmp, --individuals, --generations and --threads
+ *            followed by a number, --time-limit followed by the seconds of each datacenter, --target followed by the absolute
+ *            cost of the target quality of every datacenter or --baseline followed by the results file of an earlier benchmark
+ *            with the target cost of each datacenter, --tolerance followed by the percent of distance to the target and of the
+ *            convergence, and --seed followed by the seed of the datacenters and of the runs
+ * returns: exit state
+ */
+int main (int argc, char *argv[])
+{
+	struct bench_options options;
+	struct bench_result result;
+	struct generator_parameters parameters;
+	char path_to_file[TAM_BUFFER];
+	char *ladder, *datacenter, *next;
+	char target_text[32], target_file_text[32], convergence_text[32];
+	int iterator_argument, h_size, v_size, failures = 0;
+	double target_cost;
+	long peak_memory;
+	FILE *results_file;
+
+	options.ladder = DEFAULT_LADDER;
+	options.directory = "bench";
+	options.config = NULL;
+	options.individuals = 0;
+	options.generations = 0;
+	options.threads = 0;
+	options.time_limit = 120.0;
+	options.tolerance = 1.0;
+	options.target = 0.0;
+	options.baseline = NULL;
+	options.seed = 1;
+
+	for (iterator_argument = 1; iterator_argument + 1 < argc; iterator_argument += 2)
+	{
+		if (strcmp(argv[iterator_argument], "--ladder") == 0)
+			options.ladder = argv[iterator_argument + 1];
+		else if (strcmp(argv[iterator_argument], "--directory") == 0)
+			options.directory = argv[iterator_argument + 1];
+		else if (strcmp(argv[iterator_argument], "--config") == 0)
+			options.config = argv[iterator_argument + 1];
+		else if (strcmp(argv[iterator_argument], "--individuals") == 0)
+			options.individuals = atoi(argv[iterator_argument + 1]);
+		else if (strcmp(argv[iterator_argument], "--generations") == 0)
+			options.generations = atoi(argv[iterator_argument + 1]);
+		else if (strcmp(argv[iterator_argument], "--threads") == 0)
+			options.threads = atoi(argv[iterator_argument + 1]);
+		else if (strcmp(argv[iterator_argument], "--time-limit") == 0)
+			options.time_limit = atof(argv[iterator_argument + 1]);
+		else if (strcmp(argv[iterator_argument], "--target") == 0)
+			options.target = atof(argv[iterator_argument + 1]);
+		else if (strcmp(argv[iterator_argument], "--baseline") == 0)
+			options.baseline = argv[iterator_argument + 1];
+		else if (strcmp(argv[iterator_argument], "--tolerance") == 0)
+			options.tolerance = atof(argv[iterator_argument + 1]);
+		else if (strcmp(argv[iterator_argument], "--seed") == 0)
+			options.seed = strtoull(argv[iterator_argument + 1], NULL, 10);
+		else
+			break;
+	}
+
+	if (iterator_argument < argc)
+	{
+		fprintf(stderr, "[ERROR] Usage: %s [--ladder 4x8,120x600,...|paths] [--directory path] [--config path] [--individuals number] [--generations number] [--threads number] [--time-limit seconds] [--target cost | --baseline results_file] [--tolerance percent] [--seed number]\n", argv[0]);
+		return 1;
+	}
+
+	mkdir(options.directory, 0755);
+
+	snprintf(path_to_file, sizeof (path_to_file), "%s/benchmark_results", options.directory);
+	results_file = fopen(path_to_file, "a");
+
+	/* a new file begins with the names of the columns */
+	if (results_file != NULL && fseek(results_file, 0, SEEK_END) == 0 && ftell(results_file) == 0)
+		fprintf(results_file, "datacenter\tpms\tvms\tgenerations\tseconds\tgenerations_per_second\tevaluations_per_second\tpeak_rss_mb\tbest_cost\tabsolute_cost\ttarget_cost\ttime_to_target\tconvergence_time\tseed\n");
+
+	printf("%-24s %7s %7s %6s %10s %10s %12s %10s %12s %14s %14s %12s %12s\n", "datacenter", "PMs", "VMs", "gens", "seconds", "gens/s", "evals/s", "peak MB", "best cost",
+		"absolute cost", "target cost", "target s", "converged s");
+
+	/* the datacenters are cut from a copy of the ladder */
+	ladder = strdup(options.ladder);
+
+	if (ladder == NULL)
+	{
+		printf ("[ERROR]: Problem with memory space. Function strdup returned NULL!\n");
+		exit (EXIT_FAILURE);
+	}
+
+	for (datacenter = ladder; datacenter != NULL && *datacenter != '\0'; datacenter = next)
+	{
+		next = strchr(datacenter, ',');
+		if (next != NULL)
+			*next++ = '\0';
+
+		/* PMsxVMs is written by the generator, anything else is a datacenter file */
+		if (sscanf(datacenter, "%dx%d", &h_size, &v_size) == 2 && strchr(datacenter, '.') == NULL && strchr(datacenter, '/') == NULL)
+		{
+			snprintf(path_to_file, sizeof (path_to_file), "%s/%s.vmp", options.directory, datacenter);
+			generator_defaults(&parameters, h_size, v_size);
+			parameters.seed = options.seed;
+
+			if (!generate_datacenter(path_to_file, &parameters))
+			{
+				printf("%-24s could not be written in %s\n", datacenter, path_to_file);
+				failures++;
+				continue;
+			}
+		}
+		else
+			snprintf(path_to_file, sizeof (path_to_file), "%s", datacenter);
+
+		/* the target of the options, or the one of the datacenter in the baseline */
+		target_cost = options.target;
+		if (target_cost <= 0.0 && options.baseline != NULL)
+			target_cost = baseline_target(options.baseline, datacenter);
+
+		if (!bench_datacenter(path_to_file, &options, target_cost, &result, &peak_memory))
+		{
+			printf("%-24s failed\n", datacenter);
+			failures++;
+			continue;
+		}
+
+		/* without a target there is no time to target, and a target not reached is written as such */
+		if (target_cost <= 0.0)
+			snprintf(target_text, sizeof (target_text), "-");
+		else if (result.time_to_target < 0.0)
+			snprintf(target_text, sizeof (target_text), "not reached");
+		else
+			snprintf(target_text, sizeof (target_text), "%.3f", result.time_to_target);
+		snprintf(target_file_text, sizeof (target_file_text), "%.6f", result.time_to_target);
+		snprintf(convergence_text, sizeof (convergence_text), "%.3f", result.convergence_time);
+
+		printf("%-24s %7d %7d %6d %10.3f %10.3f %12.1f %10.1f %12.6f %14.6g %14.6g %12s %12s\n", datacenter, result.h_size, result.v_size, result.generations, result.seconds,
+			result.generations / result.seconds, result.evaluations / result.seconds, peak_memory / 1024.0, result.best_cost, result.absolute_cost, target_cost, target_text, convergence_text);
+
+		if (results_file != NULL)
+			fprintf(results_file, "%s\t%d\t%d\t%d\t%.6f\t%.6f\t%.3f\t%.3f\t%.9g\t%.9g\t%.9g\t%s\t%.6f\t%llu\n", datacenter, result.h_size, result.v_size, result.generations, result.seconds,
+				result.generations / result.seconds, result.evaluations / result.seconds, peak_memory / 1024.0, result.best_cost, result.absolute_cost, target_cost,
+				target_cost <= 0.0 ? "-" : result.time_to_target < 0.0 ? "not_reached" : target_file_text, result.convergence_time, options.seed);
+	}
+
+	free(ladder);
+
+	if (results_file != NULL)
+		fclose(results_file);
+
+	return failures > 0 ? 1 : 0;
+}
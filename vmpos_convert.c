@@ -0,0 +1,53 @@
+/*
+ * vmpos_convert.c: Virtual Machine Placement with OverSubscription Problem - Datacenter Converter
+ * Date: 17-10-2026
+ *
+ * Converts a datacenter text file (.vmp) to the binary columnar format (.vmpb), that is
+ * loaded by the VMPOS through a memory mapping, without parsing or copies.
+*/
+
+/* include libraries */
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+/* include own headers */
+#include "datacenter.h"
+
+#define CRITICAL_SERVICES 1 //Indicates if the VM run Critical Services
+
+/* main: converts a datacenter file to the binary columnar format
+ * parameter: path to the datacenter text file
+ * parameter: path to the binary datacenter file to write
+ * returns: exit state
+ */
+int main (int argc, char *argv[])
+{
+	struct datacenter datacenter;
+
+	/* parameters verification */
+	if (argc != 3)
+	{
+		fprintf(stderr, "[ERROR] Usage: %s path_to_datacenter_file path_to_binary_datacenter_file\n", argv[0]);
+		return 1;
+	}
+
+	if (!load_datacenter(argv[1], &datacenter, CRITICAL_SERVICES))
+	{
+		fprintf(stderr, "[ERROR] Could not read the datacenter file %s\n", argv[1]);
+		return 1;
+	}
+
+	if (!save_datacenter_binary(argv[2], &datacenter, CRITICAL_SERVICES))
+	{
+		fprintf(stderr, "[ERROR] Could not write the binary datacenter file %s\n", argv[2]);
+		free_datacenter(&datacenter);
+		return 1;
+	}
+
+	printf("%s: %d PMs, %d VMs (%d with critical services) written to %s\n", argv[1], datacenter.h_size, datacenter.v_size, datacenter.number_vms_sc, argv[2]);
+
+	free_datacenter(&datacenter);
+
+	return 0;
+}
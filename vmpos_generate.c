@@ -0,0 +1,63 @@
+/*
+ * vmpos_generate.c: Virtual Machine Placement with OverSubscription Problem - Datacenter Generator
+ * Date: 17-10-2026
+ *
+ * Writes a synthetic datacenter file (.vmp) with the number of PMs and VMs given, to test
+ * the VMPOS with datacenters of any size (see generator.h).
+*/
+
+/* include libraries */
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+/* include own headers */
+#include "generator.h"
+
+/* main: writes a synthetic datacenter file
+ * parameter: number of physical machines, number of virtual machines and path of the file to write.
+ *            Optionally --critical followed by the part of the VMs with critical services, --load followed by
+ *            the load factor, --distribution followed by uniform or skewed and --seed followed by the seed
+ * returns: exit state
+ */
+int main (int argc, char *argv[])
+{
+	struct generator_parameters parameters;
+	int iterator_argument;
+
+	/* parameters verification */
+	if (argc < 4 || atoi(argv[1]) < 1 || atoi(argv[2]) < 1)
+	{
+		fprintf(stderr, "[ERROR] Usage: %s number_of_pms number_of_vms path_to_datacenter_file [--critical ratio] [--load factor] [--distribution uniform|skewed] [--seed number]\n", argv[0]);
+		return 1;
+	}
+
+	generator_defaults(&parameters, atoi(argv[1]), atoi(argv[2]));
+
+	for (iterator_argument = 4; iterator_argument + 1 < argc; iterator_argument += 2)
+	{
+		if (strcmp(argv[iterator_argument], "--critical") == 0)
+			parameters.critical_ratio = atof(argv[iterator_argument + 1]);
+		else if (strcmp(argv[iterator_argument], "--load") == 0)
+			parameters.load_factor = atof(argv[iterator_argument + 1]);
+		else if (strcmp(argv[iterator_argument], "--distribution") == 0)
+			parameters.distribution = strcmp(argv[iterator_argument + 1], "skewed") == 0 ? SKEWED_DISTRIBUTION : UNIFORM_DISTRIBUTION;
+		else if (strcmp(argv[iterator_argument], "--seed") == 0)
+			parameters.seed = strtoull(argv[iterator_argument + 1], NULL, 10);
+		else
+		{
+			fprintf(stderr, "[ERROR] Unknown option %s\n", argv[iterator_argument]);
+			return 1;
+		}
+	}
+
+	if (!generate_datacenter(argv[3], &parameters))
+	{
+		fprintf(stderr, "[ERROR] Could not write the datacenter file %s\n", argv[3]);
+		return 1;
+	}
+
+	printf("%s: %d PMs, %d VMs, load factor %g, %g of the VMs with critical services\n", argv[3], parameters.h_size, parameters.v_size, parameters.load_factor, parameters.critical_ratio);
+
+	return 0;
+}
@@ -0,0 +1,702 @@
+/*
+ * vmpos_kernels.c: Virtual Machine Placement with OverSubscription Problem - Kernel Microbenchmarks
+ * Date: 17-10-2026
+ *
+ * Times the hot functions of the VMPOS one by one, on inputs that are always the same for the
+ * same datacenter and seed: a population of random individuals, the same population repaired,
+ * and after the local search, and a set of objective vectors with their placements. The number
+ * of operations of a repetition is calibrated to a minimum time, then some repetitions are run
+ * as warmup and the nanoseconds per operation of the next repetitions are reported with their
+ * median, minimum, mean and standard deviation. The kernels that change the population (repair
+ * and local search) restore it out of the measured time.
+*/
+
+/* include libraries */
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+#include <sys/stat.h>
+
+/* include own headers */
+#include "common.h"
+#include "datacenter.h"
+#include "context.h"
+#include "generator.h"
+#include "initialization.h"
+#include "commitment.h"
+#include "evaluation.h"
+#include "reparation.h"
+#include "local_search.h"
+#include "variation.h"
+#include "offspring.h"
+#include "pareto.h"
+
+#define CRITICAL_SERVICES 1 //Indicates if the VM run Critical Services
+
+/* maximum number of repetitions measured */
+#define MAX_REPETITIONS 1000
+
+/* inputs of the kernels */
+struct kernel_data
+{
+	struct datacenter datacenter;
+	struct vmpos_context *context;
+	int number_of_individuals;
+	int h_size;
+	int v_size;
+	/* population the kernels work on, its commitment matrix and the PMs usable by each individual */
+	struct population *population;
+	float **cm;
+	int *h_sizes;
+	/* arena of the commitment matrix, and arena of the results of a kernel, reset before each operation */
+	struct arena *arena;
+	struct arena *scratch;
+	/* genes of the population: random, repaired and after the local search, and the ones loaded now */
+	int *random_genes;
+	int *repaired_genes;
+	int *searched_genes;
+	int *loaded_genes;
+	/* objective vectors and placements of the dominance, sorting and archive kernels */
+	int number_of_solutions;
+	float **solutions;
+	struct population *placements;
+	struct rng rng;
+};
+
+/* a kernel: runs a number of operations and returns the nanoseconds they took */
+struct kernel
+{
+	const char *name;
+	const char *operation;
+	double (*run)(struct kernel_data *data, long operations);
+};
+
+/* results of the kernels are added here, so the compiler does not remove the calls */
+static volatile long kernel_sink;
+
+/* elapsed_nanoseconds: nanoseconds since a moment of the monotonic clock
+ * parameter: the moment
+ * returns: nanoseconds
+*/
+static double elapsed_nanoseconds(struct timespec *start)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	return (double) (now.tv_sec - start->tv_sec) * 1e9 + (double) (now.tv_nsec - start->tv_nsec);
+}
+
+/* kernel_memory: malloc that finishes the program if there is no memory
+ * parameter: size in bytes
+ * returns: the reserved memory
+*/
+static void *kernel_memory(size_t size)
+{
+	void *memory = malloc (size);
+
+	if (memory == NULL)
+	{
+		printf ("[ERROR]: Problem with memory space. Function malloc returned NULL!\n");
+		exit (EXIT_FAILURE);
+	}
+	return memory;
+}
+
+/* load_genes: loads genes in the population, with its utilization, commitment matrix and evaluation
+ * parameter: inputs of the kernels
+ * parameter: genes of all the individuals
+ * returns: nothing, it's void
+*/
+static void load_genes(struct kernel_data *data, int *genes)
+{
+	int iterator_individual;
+	int n = data->number_of_individuals;
+	struct datacenter *datacenter = &data->datacenter;
+
+	memcpy(data->population->genes, genes, (size_t) n * data->v_size * sizeof (int));
+	load_utilization(data->population, datacenter->H, datacenter->V, n, data->h_size, data->v_size);
+	arena_reset(data->arena);
+	data->cm = calculates_commitment(data->context, data->population, n, data->h_size, data->v_size, datacenter->V, CRITICAL_SERVICES, data->arena);
+	load_evaluation(data->context, data->population, data->cm, datacenter->H, datacenter->V, n, data->h_size, data->v_size, CRITICAL_SERVICES);
+
+	for (iterator_individual = 0; iterator_individual < n; iterator_individual++)
+		data->h_sizes[iterator_individual] = data->h_size;
+
+	data->loaded_genes = genes;
+}
+
+/* copy_genes: copies the genes of the population
+ * parameter: inputs of the kernels
+ * returns: copy of the genes
+*/
+static int *copy_genes(struct kernel_data *data)
+{
+	size_t size = (size_t) data->number_of_individuals * data->v_size * sizeof (int);
+	int *genes = (int *) kernel_memory (size);
+
+	memcpy(genes, data->population->genes, size);
+
+	return genes;
+}
+
+/* kernel_is_dominated: dominance of two objective vectors */
+static double kernel_is_dominated(struct kernel_data *data, long operations)
+{
+	long iterator_operation;
+	long sum = 0;
+	int a = 0, b = 1;
+	struct timespec start;
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (iterator_operation = 0; iterator_operation < operations; iterator_operation++)
+	{
+		sum += is_dominated(data->solutions, a, b);
+		if (++b == data->number_of_solutions)
+		{
+			b = 0;
+			if (++a == data->number_of_solutions)
+				a = 0;
+		}
+	}
+	kernel_sink += sum;
+
+	return elapsed_nanoseconds(&start);
+}
+
+/* kernel_non_dominated_sorting: fronts of all the objective vectors */
+static double kernel_non_dominated_sorting(struct kernel_data *data, long operations)
+{
+	long iterator_operation;
+	struct timespec start;
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (iterator_operation = 0; iterator_operation < operations; iterator_operation++)
+	{
+		arena_reset(data->scratch);
+		kernel_sink += non_dominated_sorting(data->solutions, data->number_of_solutions, data->scratch)[0];
+	}
+
+	return elapsed_nanoseconds(&start);
+}
+
+/* kernel_load_objectives: objective functions of the population after the local search, from the partial sums */
+static double kernel_load_objectives(struct kernel_data *data, long operations)
+{
+	long iterator_operation;
+	struct datacenter *datacenter = &data->datacenter;
+	struct timespec start;
+
+	if (data->loaded_genes != data->searched_genes)
+		load_genes(data, data->searched_genes);
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (iterator_operation = 0; iterator_operation < operations; iterator_operation++)
+	{
+		arena_reset(data->scratch);
+		kernel_sink += (long) load_objectives(data->context, data->population, data->cm, datacenter->H, datacenter->V, data->number_of_individuals, data->h_size, data->v_size, data->context->base_solution, CRITICAL_SERVICES, data->scratch)[0][0];
+	}
+
+	return elapsed_nanoseconds(&start);
+}
+
+/* kernel_load_objectives_full: objective functions of the population recalculated from the placements, without partial sums */
+static double kernel_load_objectives_full(struct kernel_data *data, long operations)
+{
+	long iterator_operation;
+	struct datacenter *datacenter = &data->datacenter;
+	struct individual_evaluation *evaluation;
+	struct timespec start;
+
+	if (data->loaded_genes != data->searched_genes)
+		load_genes(data, data->searched_genes);
+
+	/* without the evaluation, load_objectives goes through all the VMs of each PM on */
+	evaluation = data->population->evaluation;
+	data->population->evaluation = NULL;
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (iterator_operation = 0; iterator_operation < operations; iterator_operation++)
+	{
+		arena_reset(data->scratch);
+		kernel_sink += (long) load_objectives(data->context, data->population, data->cm, datacenter->H, datacenter->V, data->number_of_individuals, data->h_size, data->v_size, data->context->base_solution, CRITICAL_SERVICES, data->scratch)[0][0];
+	}
+	data->population->evaluation = evaluation;
+
+	return elapsed_nanoseconds(&start);
+}
+
+/* kernel_load_utilization: utilization of the PMs of the population */
+static double kernel_load_utilization(struct kernel_data *data, long operations)
+{
+	long iterator_operation;
+	struct datacenter *datacenter = &data->datacenter;
+	struct timespec start;
+
+	if (data->loaded_genes != data->searched_genes)
+		load_genes(data, data->searched_genes);
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (iterator_operation = 0; iterator_operation < operations; iterator_operation++)
+		load_utilization(data->population, datacenter->H, datacenter->V, data->number_of_individuals, data->h_size, data->v_size);
+	kernel_sink += data->population->utilization[0];
+
+	return elapsed_nanoseconds(&start);
+}
+
+/* kernel_calculates_commitment: commitment matrix of the population */
+static double kernel_calculates_commitment(struct kernel_data *data, long operations)
+{
+	long iterator_operation;
+	struct timespec start;
+
+	if (data->loaded_genes != data->searched_genes)
+		load_genes(data, data->searched_genes);
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (iterator_operation = 0; iterator_operation < operations; iterator_operation++)
+	{
+		arena_reset(data->scratch);
+		kernel_sink += (long) calculates_commitment(data->context, data->population, data->number_of_individuals, data->h_size, data->v_size, data->datacenter.V, CRITICAL_SERVICES, data->scratch)[0][0];
+	}
+
+	return elapsed_nanoseconds(&start);
+}
+
+/* kernel_calculates_commitment_line: verification of the commitment of a PM that receives a VM */
+static double kernel_calculates_commitment_line(struct kernel_data *data, long operations)
+{
+	long iterator_operation;
+	long sum = 0;
+	int individual = 0, virtual_machine = 0, physical = 0;
+	struct timespec start;
+
+	if (data->loaded_genes != data->searched_genes)
+		load_genes(data, data->searched_genes);
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (iterator_operation = 0; iterator_operation < operations; iterator_operation++)
+	{
+		sum += calculates_commitment_line(data->context, data->population, data->cm, data->datacenter.V, individual, virtual_machine, physical + 1, CRITICAL_SERVICES);
+		if (++virtual_machine == data->v_size)
+			virtual_machine = 0;
+		if (++physical == data->h_size)
+			physical = 0;
+		if (++individual == data->number_of_individuals)
+			individual = 0;
+	}
+	kernel_sink += sum;
+
+	return elapsed_nanoseconds(&start);
+}
+
+/* kernel_commitment_level: commitment of a PM, the update of the commitment matrix on a VM move */
+static double kernel_commitment_level(struct kernel_data *data, long operations)
+{
+	long iterator_operation;
+	float sum = 0.0;
+	int individual = 0, physical = 0;
+	struct timespec start;
+
+	if (data->loaded_genes != data->searched_genes)
+		load_genes(data, data->searched_genes);
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (iterator_operation = 0; iterator_operation < operations; iterator_operation++)
+	{
+		sum += commitment_level(data->context, data->population, individual, physical);
+		if (++physical == data->h_size)
+		{
+			physical = 0;
+			if (++individual == data->number_of_individuals)
+				individual = 0;
+		}
+	}
+	kernel_sink += (long) sum;
+
+	return elapsed_nanoseconds(&start);
+}
+
+/* kernel_repair_individual: repair of a random individual, the population is restored out of the time */
+static double kernel_repair_individual(struct kernel_data *data, long operations)
+{
+	long iterator_operation;
+	int individual = 0;
+	double nanoseconds = 0.0;
+	struct datacenter *datacenter = &data->datacenter;
+	struct timespec start;
+
+	for (iterator_operation = 0; iterator_operation < operations; iterator_operation++)
+	{
+		if (individual == 0)
+		{
+			/* the streams are seeded again, so every round repairs the same way */
+			load_genes(data, data->random_genes);
+			rng_seed(&data->rng, (uint64_t) data->context->seed);
+			clock_gettime(CLOCK_MONOTONIC, &start);
+		}
+
+		repair_individual(data->context, data->population, data->cm, datacenter->H, datacenter->V, data->h_sizes, data->h_size, data->v_size, CRITICAL_SERVICES, individual, &data->rng);
+
+		if (++individual == data->number_of_individuals || iterator_operation == operations - 1)
+		{
+			nanoseconds += elapsed_nanoseconds(&start);
+			individual = 0;
+		}
+	}
+	data->loaded_genes = NULL;
+
+	return nanoseconds;
+}
+
+/* kernel_local_search: local search of a repaired individual, the population is restored out of the time */
+static double kernel_local_search(struct kernel_data *data, long operations)
+{
+	long iterator_operation;
+	int individual = 0;
+	double nanoseconds = 0.0;
+	struct datacenter *datacenter = &data->datacenter;
+	struct timespec start;
+
+	for (iterator_operation = 0; iterator_operation < operations; iterator_operation++)
+	{
+		if (individual == 0)
+		{
+			load_genes(data, data->repaired_genes);
+			clock_gettime(CLOCK_MONOTONIC, &start);
+		}
+
+		local_search_individual(data->context, data->population, data->cm, datacenter->H, datacenter->V, data->h_sizes, data->h_size, data->v_size, CRITICAL_SERVICES, individual);
+
+		if (++individual == data->number_of_individuals || iterator_operation == operations - 1)
+		{
+			nanoseconds += elapsed_nanoseconds(&start);
+			individual = 0;
+		}
+	}
+	data->loaded_genes = NULL;
+
+	return nanoseconds;
+}
+
+/* kernel_pareto_insert: insertion of a solution in an archive, that begins empty every round */
+static double kernel_pareto_insert(struct kernel_data *data, long operations)
+{
+	long iterator_operation;
+	int solution = 0;
+	double nanoseconds = 0.0;
+	struct pareto_archive *archive = NULL;
+	struct timespec start;
+
+	for (iterator_operation = 0; iterator_operation < operations; iterator_operation++)
+	{
+		if (solution == 0)
+		{
+			archive = pareto_create(data->context, data->v_size, data->context->archive_max_size);
+			clock_gettime(CLOCK_MONOTONIC, &start);
+		}
+
+		kernel_sink += pareto_insert(archive, INDIVIDUAL(data->placements, solution), data->solutions[solution]);
+
+		if (++solution == data->number_of_solutions || iterator_operation == operations - 1)
+		{
+			nanoseconds += elapsed_nanoseconds(&start);
+			free_pareto_archive(archive);
+			solution = 0;
+		}
+	}
+
+	return nanoseconds;
+}
+
+/* kernel_migration_cost: migration cost of an individual after the local search */
+static double kernel_migration_cost(struct kernel_data *data, long operations)
+{
+	long iterator_operation;
+	float sum = 0.0;
+	int individual = 0;
+	struct timespec start;
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (iterator_operation = 0; iterator_operation < operations; iterator_operation++)
+	{
+		sum += migration_cost(data->context, data->datacenter.V, data->context->base_solution, data->searched_genes + (size_t) individual * data->v_size, data->v_size, CRITICAL_SERVICES);
+		if (++individual == data->number_of_individuals)
+			individual = 0;
+	}
+	kernel_sink += (long) sum;
+
+	return elapsed_nanoseconds(&start);
+}
+
+/* the kernels, in the order of the report */
+static struct kernel kernels[] = {
+	{"is_dominated", "comparison", kernel_is_dominated},
+	{"non_dominated_sorting", "sorting of the solutions", kernel_non_dominated_sorting},
+	{"load_objectives", "population", kernel_load_objectives},
+	{"load_objectives_full", "population", kernel_load_objectives_full},
+	{"load_utilization", "population", kernel_load_utilization},
+	{"calculates_commitment", "population", kernel_calculates_commitment},
+	{"calculates_commitment_line", "VM and PM", kernel_calculates_commitment_line},
+	{"commitment_level", "PM", kernel_commitment_level},
+	{"repair_individual", "individual", kernel_repair_individual},
+	{"local_search", "individual", kernel_local_search},
+	{"pareto_insert", "solution", kernel_pareto_insert},
+	{"migration_cost", "individual", kernel_migration_cost}
+};
+
+/* load_kernel_data: builds the inputs of the kernels
+ * parameter: inputs to fill
+ * parameter: path to the datacenter file
+ * parameter: number of individuals of the population
+ * parameter: number of objective vectors
+ * parameter: seed of the inputs
+ * returns: 1 if the datacenter was loaded, 0 if not
+*/
+static int load_kernel_data(struct kernel_data *data, char path_to_file[], int number_of_individuals, int number_of_solutions, unsigned long long seed)
+{
+	int iterator_solution;
+	float *solutions_data;
+	float u, v;
+	struct population *base_population;
+	struct rng *streams;
+	struct datacenter *datacenter = &data->datacenter;
+
+	if (!load_datacenter(path_to_file, datacenter, CRITICAL_SERVICES))
+		return 0;
+
+	data->number_of_individuals = number_of_individuals;
+	data->number_of_solutions = number_of_solutions;
+	data->h_size = datacenter->h_size;
+	data->v_size = datacenter->v_size;
+
+	/* the configuration of the example vmpos_config.vmp */
+	data->context = vmpos_create(datacenter, CRITICAL_SERVICES);
+	data->context->total_of_individuals = number_of_individuals;
+	data->context->energy_objective_weight = 1.0;
+	data->context->dispersion_objective_weight = 1.0;
+	data->context->migration_objective_weight = 1.0;
+	data->context->cl_cs = 1.0;
+	data->context->cl_nc = 2.0;
+	data->context->mc_cs = 2.0;
+	data->context->mc_ncs = 1.0;
+	data->context->seed = seed;
+	rng_seed(&data->rng, (uint64_t) seed);
+
+	/* a random base solution, like in a solve without base solution file */
+	base_population = initialization(1, data->h_size, data->v_size, datacenter->V, CRITICAL_SERVICES, &data->rng, NULL);
+	data->context->base_solution = generate_base_solution(base_population, data->v_size, 0);
+	population_free(base_population);
+
+	data->arena = arena_create((size_t) number_of_individuals * data->h_size * sizeof (float));
+	data->scratch = arena_create((size_t) number_of_solutions * 64 * sizeof (int));
+	data->h_sizes = (int *) kernel_memory (number_of_individuals * sizeof (int));
+
+	/* the random population, repaired and after the local search */
+	data->population = initialization(number_of_individuals, data->h_size, data->v_size, datacenter->V, CRITICAL_SERVICES, &data->rng, NULL);
+	data->random_genes = copy_genes(data);
+	load_genes(data, data->random_genes);
+
+	streams = load_streams(&data->rng, number_of_individuals, NULL);
+	repair_population(data->context, data->population, data->cm, datacenter->H, datacenter->V, data->h_sizes, number_of_individuals, data->h_size, data->v_size, CRITICAL_SERVICES, streams);
+	free(streams);
+	data->repaired_genes = copy_genes(data);
+
+	local_search(data->context, data->population, data->cm, datacenter->H, datacenter->V, data->h_sizes, number_of_individuals, data->h_size, data->v_size, CRITICAL_SERVICES);
+	data->searched_genes = copy_genes(data);
+	load_genes(data, data->searched_genes);
+
+	/* objective vectors around a plane, so part of them are dominated and part are not, with random placements */
+	data->solutions = (float **) kernel_memory (number_of_solutions * sizeof (float *));
+	solutions_data = (float *) kernel_memory ((size_t) number_of_solutions * 3 * sizeof (float));
+	for (iterator_solution = 0; iterator_solution < number_of_solutions; iterator_solution++)
+	{
+		u = rng_uniform(&data->rng);
+		v = rng_uniform(&data->rng);
+		data->solutions[iterator_solution] = solutions_data + (size_t) iterator_solution * 3;
+		data->solutions[iterator_solution][0] = 1000.0 * u;
+		data->solutions[iterator_solution][1] = v;
+		data->solutions[iterator_solution][2] = 100.0 * (1.0 - 0.5 * (u + v) + 0.2 * rng_uniform(&data->rng));
+	}
+	data->placements = initialization(number_of_solutions, data->h_size, data->v_size, datacenter->V, CRITICAL_SERVICES, &data->rng, NULL);
+
+	return 1;
+}
+
+/* free_kernel_data: frees the inputs of the kernels
+ * parameter: inputs
+ * returns: nothing, it's void
+*/
+static void free_kernel_data(struct kernel_data *data)
+{
+	population_free(data->placements);
+	free(data->solutions[0]);
+	free(data->solutions);
+	free(data->searched_genes);
+	free(data->repaired_genes);
+	free(data->random_genes);
+	population_free(data->population);
+	free(data->h_sizes);
+	arena_free(data->scratch);
+	arena_free(data->arena);
+	vmpos_destroy(data->context);
+	free_datacenter(&data->datacenter);
+}
+
+/* compare_double: increasing order of two numbers, for qsort
+ * parameter: first number
+ * parameter: second number
+ * returns: negative, zero or positive as the first is lower, equal or greater than the second
+*/
+static int compare_double(const void *first, const void *second)
+{
+	double a = *(const double *) first;
+	double b = *(const double *) second;
+
+	return (a > b) - (a < b);
+}
+
+/* measure_kernel: calibrates, warms up and measures a kernel, and writes its line of the report
+ * parameter: kernel
+ * parameter: inputs of the kernels
+ * parameter: minimum nanoseconds of a repetition
+ * parameter: repetitions of warmup
+ * parameter: repetitions measured
+ * returns: nothing, it's void
+*/
+static void measure_kernel(struct kernel *kernel, struct kernel_data *data, double minimum_nanoseconds, int warmup, int repetitions)
+{
+	int iterator_repetition;
+	long operations = 1;
+	double nanoseconds, mean = 0.0, deviation = 0.0, median;
+	double samples[MAX_REPETITIONS];
+
+	/* the operations are doubled until a repetition takes the minimum time, then scaled to it */
+	while ((nanoseconds = kernel->run(data, operations)) < minimum_nanoseconds && operations < (1L << 40))
+		operations *= 2;
+	if (nanoseconds < minimum_nanoseconds)
+		operations = (long) ceil(operations * minimum_nanoseconds / (nanoseconds > 1.0 ? nanoseconds : 1.0));
+
+	for (iterator_repetition = 0; iterator_repetition < warmup; iterator_repetition++)
+		kernel->run(data, operations);
+
+	for (iterator_repetition = 0; iterator_repetition < repetitions; iterator_repetition++)
+	{
+		samples[iterator_repetition] = kernel->run(data, operations) / operations;
+		mean += samples[iterator_repetition];
+	}
+	mean /= repetitions;
+
+	for (iterator_repetition = 0; iterator_repetition < repetitions; iterator_repetition++)
+		deviation += (samples[iterator_repetition] - mean) * (samples[iterator_repetition] - mean);
+	deviation = repetitions > 1 ? sqrt(deviation / (repetitions - 1)) : 0.0;
+
+	qsort(samples, repetitions, sizeof (double), compare_double);
+	median = repetitions % 2 ? samples[repetitions / 2] : 0.5 * (samples[repetitions / 2 - 1] + samples[repetitions / 2]);
+
+	printf("%-28s %-26s %10ld %14.1f %14.1f %14.1f %8.2f %14.1f\n", kernel->name, kernel->operation, operations, median, samples[0], mean,
+		mean > 0.0 ? 100.0 * deviation / mean : 0.0, median > 0.0 ? 1e9 / median : 0.0);
+}
+
+/* main: microbenchmarks of the hot functions of the VMPOS
+ * parameter: optionally --datacenter followed by PMsxVMs to generate the datacenter or by the path of a datacenter file,
+ *            --directory followed by the directory of the generated datacenter, --individuals followed by the individuals
+ *            of the population, --solutions followed by the objective vectors, --repetitions and --warmup followed by the
+ *            repetitions measured and of warmup, --min-time followed by the milliseconds of a repetition, --kernel followed
+ *            by the name of the only kernel to run and --seed followed by the seed of the inputs
+ * returns: exit state
+ */
+int main (int argc, char *argv[])
+{
+	struct kernel_data data;
+	struct generator_parameters parameters;
+	char path_to_file[TAM_BUFFER];
+	char *datacenter = "120x600";
+	char *directory = "bench";
+	char *only_kernel = NULL;
+	int number_of_individuals = 50, number_of_solutions = 1000, repetitions = 10, warmup = 2;
+	int iterator_argument, iterator_kernel, h_size, v_size, measured = 0;
+	double minimum_milliseconds = 20.0;
+	unsigned long long seed = 1;
+
+	for (iterator_argument = 1; iterator_argument + 1 < argc; iterator_argument += 2)
+	{
+		if (strcmp(argv[iterator_argument], "--datacenter") == 0)
+			datacenter = argv[iterator_argument + 1];
+		else if (strcmp(argv[iterator_argument], "--directory") == 0)
+			directory = argv[iterator_argument + 1];
+		else if (strcmp(argv[iterator_argument], "--individuals") == 0)
+			number_of_individuals = atoi(argv[iterator_argument + 1]);
+		else if (strcmp(argv[iterator_argument], "--solutions") == 0)
+			number_of_solutions = atoi(argv[iterator_argument + 1]);
+		else if (strcmp(argv[iterator_argument], "--repetitions") == 0)
+			repetitions = atoi(argv[iterator_argument + 1]);
+		else if (strcmp(argv[iterator_argument], "--warmup") == 0)
+			warmup = atoi(argv[iterator_argument + 1]);
+		else if (strcmp(argv[iterator_argument], "--min-time") == 0)
+			minimum_milliseconds = atof(argv[iterator_argument + 1]);
+		else if (strcmp(argv[iterator_argument], "--kernel") == 0)
+			only_kernel = argv[iterator_argument + 1];
+		else if (strcmp(argv[iterator_argument], "--seed") == 0)
+			seed = strtoull(argv[iterator_argument + 1], NULL, 10);
+		else
+			break;
+	}
+
+	if (iterator_argument < argc || number_of_individuals < 2 || number_of_solutions < 2 || repetitions < 1 || repetitions > MAX_REPETITIONS || warmup < 0)
+	{
+		fprintf(stderr, "[ERROR] Usage: %s [--datacenter PMsxVMs|path] [--directory path] [--individuals number] [--solutions number] [--repetitions 1..%d] [--warmup number] [--min-time milliseconds] [--kernel name] [--seed number]\n", argv[0], MAX_REPETITIONS);
+		return 1;
+	}
+
+	for (iterator_kernel = 0; iterator_kernel < (int) (sizeof (kernels) / sizeof (kernels[0])); iterator_kernel++)
+		if (only_kernel == NULL || strcmp(only_kernel, kernels[iterator_kernel].name) == 0)
+			measured++;
+
+	if (measured == 0)
+	{
+		fprintf(stderr, "[ERROR] Unknown kernel %s\n", only_kernel);
+		return 1;
+	}
+
+	/* PMsxVMs is written by the generator, anything else is a datacenter file */
+	if (sscanf(datacenter, "%dx%d", &h_size, &v_size) == 2 && strchr(datacenter, '.') == NULL && strchr(datacenter, '/') == NULL)
+	{
+		mkdir(directory, 0755);
+		snprintf(path_to_file, sizeof (path_to_file), "%s/%s.vmp", directory, datacenter);
+		generator_defaults(&parameters, h_size, v_size);
+		parameters.seed = seed;
+
+		if (!generate_datacenter(path_to_file, &parameters))
+		{
+			fprintf(stderr, "[ERROR] Could not write the datacenter file %s\n", path_to_file);
+			return 1;
+		}
+	}
+	else
+		snprintf(path_to_file, sizeof (path_to_file), "%s", datacenter);
+
+	if (!load_kernel_data(&data, path_to_file, number_of_individuals, number_of_solutions, seed))
+	{
+		fprintf(stderr, "[ERROR] Could not read the datacenter file %s\n", path_to_file);
+		return 1;
+	}
+
+	printf("KERNELS: datacenter %s (%d PMs, %d VMs), %d individuals, %d solutions, seed %llu, %d warmup and %d measured repetitions of at least %g ms\n",
+		datacenter, data.h_size, data.v_size, number_of_individuals, number_of_solutions, seed, warmup, repetitions, minimum_milliseconds);
+	printf("%-28s %-26s %10s %14s %14s %14s %8s %14s\n", "kernel", "operation", "ops/rep", "median ns/op", "min ns/op", "mean ns/op", "stdev %", "ops/s");
+
+	for (iterator_kernel = 0; iterator_kernel < (int) (sizeof (kernels) / sizeof (kernels[0])); iterator_kernel++)
+	{
+		if (only_kernel != NULL && strcmp(only_kernel, kernels[iterator_kernel].name) != 0)
+			continue;
+
+		measure_kernel(&kernels[iterator_kernel], &data, minimum_milliseconds * 1e6, warmup, repetitions);
+	}
+
+	free_kernel_data(&data);
+
+	return 0;
+}